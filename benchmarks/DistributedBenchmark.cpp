@@ -0,0 +1,131 @@
+// Scaling of the communicators and of data-parallel training with the number of
+// forked ranks: allreduce time per vector length, then the time of one
+// DataParallel step of an MLP on a fixed global batch. The argument sets the
+// largest rank count (default 4). Timings on a machine with fewer cores than
+// ranks measure contention, not scaling.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "distributed/DataParallel.h"
+#include "distributed/Launch.h"
+#include "distributed/SharedMemoryCommunicator.h"
+#include "distributed/SocketCommunicator.h"
+#include "loss/mse/MSE.h"
+#include "model/sequential/Sequential.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    using namespace distributed;
+    using Clock = std::chrono::steady_clock;
+
+    enum class Kind { shared_memory, unix_ring };
+
+    const char* label(const Kind kind) {
+        return kind == Kind::shared_memory ? "shared memory" : "unix ring";
+    }
+
+    std::unique_ptr<Communicator> connect(const Kind kind, const std::string& name, const size_t rank,
+                                          const size_t size) {
+        if (kind == Kind::shared_memory) {
+            return std::make_unique<SharedMemoryCommunicator>(name, rank, size);
+        }
+        return SocketCommunicator::unix_ring(name, rank, size);
+    }
+
+    std::string unique_name(const char* what) {
+        return std::string("gd_bench_") + what + "_" + std::to_string(::getpid());
+    }
+
+    double milliseconds(const Clock::duration elapsed) {
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    }
+
+    void bench_allreduce(const Kind kind, const size_t max_ranks) {
+        std::printf("\nallreduce, %s: ms per call (GB/s of vector per rank)\n%10s", label(kind), "doubles");
+        for (size_t n = 1; n <= max_ranks; ++n) std::printf("  %13zu rank%s", n, n == 1 ? " " : "s");
+        std::printf("\n");
+
+        for (const size_t length : {size_t{1} << 10, size_t{1} << 16, size_t{1} << 20, size_t{1} << 23}) {
+            std::printf("%10zu", length);
+            std::fflush(stdout);
+            for (size_t n = 1; n <= max_ranks; ++n) {
+                const std::string name = unique_name("allreduce");
+                const int repeats = length >= (size_t{1} << 20) ? 5 : 50;
+                launch(n, [&](const size_t rank, const size_t size) {
+                    const auto comm = connect(kind, name, rank, size);
+                    std::vector<double> values(length, 1.0);
+                    comm->allreduce(values); // warm up pages and connections
+                    comm->barrier();
+                    const auto start = Clock::now();
+                    for (int r = 0; r < repeats; ++r) comm->allreduce(values);
+                    const double ms = milliseconds(Clock::now() - start) / repeats;
+                    if (rank == 0 && size == 1) {
+                        std::printf("  %9.3f (   -  )", ms); // Nothing to exchange
+                    } else if (rank == 0) {
+                        const double gbs = static_cast<double>(length * sizeof(double)) / (ms * 1e6);
+                        std::printf("  %9.3f (%6.2f)", ms, gbs);
+                    }
+                    std::fflush(stdout);
+                });
+            }
+            std::printf("\n");
+        }
+    }
+
+    // Strong scaling: the global batch stays fixed and is sharded over the ranks.
+    void bench_training(const Kind kind, const size_t max_ranks) {
+        constexpr size_t rows = 8192;
+        constexpr size_t features = 32;
+        constexpr int steps = 10;
+        std::mt19937_64 rng(1);
+        std::normal_distribution<double> normal;
+        std::vector<double> X(rows * features);
+        std::vector<double> y(rows);
+        for (auto& v : X) v = normal(rng);
+        for (auto& v : y) v = normal(rng);
+
+        std::printf("\nDataParallel MLP %zu-64-64-1 on %zu rows, %s: ms per step\n", features, rows, label(kind));
+        for (size_t n = 1; n <= max_ranks; ++n) {
+            const std::string name = unique_name("train");
+            launch(n, [&](const size_t rank, const size_t size) {
+                const auto comm = connect(kind, name, rank, size);
+                const auto model = Sequential<double>::mlp({features, 64, 64, 1}, 7, 1);
+                Vanilla<double> optimizer;
+                MSE<double> loss;
+                DataParallel<double> parallel(optimizer, *comm);
+                parallel.sync_parameters(*model);
+
+                const auto part = shard(rows, rank, size);
+                const MatrixView<double> local{X.data() + part.begin * features, part.end - part.begin, features,
+                                               features};
+                const std::vector<double> targets(y.begin() + part.begin, y.begin() + part.end);
+                parallel.train(*model, local, targets, loss, 0.01);
+                comm->barrier();
+
+                const auto start = Clock::now();
+                for (int s = 0; s < steps; ++s) parallel.train(*model, local, targets, loss, 0.01);
+                const double ms = milliseconds(Clock::now() - start) / steps;
+                if (rank == 0) std::printf("%2zu rank%s %9.2f\n", size, size == 1 ? " " : "s", ms);
+            });
+        }
+    }
+
+}
+
+int main(const int argc, char** argv) {
+    const size_t max_ranks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4;
+    std::printf("up to %zu ranks on %u hardware threads\n", max_ranks, std::thread::hardware_concurrency());
+    for (const Kind kind : {Kind::shared_memory, Kind::unix_ring}) {
+        bench_allreduce(kind, max_ranks);
+    }
+    for (const Kind kind : {Kind::shared_memory, Kind::unix_ring}) {
+        bench_training(kind, max_ranks);
+    }
+}
@@ -0,0 +1,66 @@
+// Throughput of the vector kernels against a std:: loop over the same buffer.
+// Set AUTODIFF_KERNELS=scalar to time the portable fallback instead of AVX2.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+#include "autodiff/kernels/Kernels.h"
+
+namespace {
+
+    using namespace autodiff;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t length = 1 << 16;
+    constexpr int repeats = 200;
+
+    // Keeps the compiler from dropping a loop whose results are never read.
+    void consume(const void* p) {
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    template <typename T, typename Kernel, typename Reference>
+    void bench(const char* name, Kernel kernel, Reference reference, const double lo, const double hi) {
+        std::mt19937_64 rng(1);
+        std::uniform_real_distribution<double> value(lo, hi);
+        std::vector<T> x(length);
+        std::vector<T> y(length);
+        for (auto& v : x) v = static_cast<T>(value(rng));
+
+        const auto start = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            kernel(std::span<const T>(x), std::span<T>(y));
+            consume(y.data());
+        }
+        const auto middle = Clock::now();
+        for (int r = 0; r < repeats; ++r) {
+            for (size_t i = 0; i < length; ++i) y[i] = reference(x[i]);
+            consume(y.data());
+        }
+        const auto end = Clock::now();
+
+        const double per_element = 1e9 / (static_cast<double>(repeats) * length);
+        const double kernel_ns = std::chrono::duration<double>(middle - start).count() * per_element;
+        const double std_ns = std::chrono::duration<double>(end - middle).count() * per_element;
+        std::printf("%-5s %-6s kernel %6.2f ns/elem   std %6.2f ns/elem   speedup %5.1fx\n", name,
+                    sizeof(T) == 4 ? "float" : "double", kernel_ns, std_ns, std_ns / kernel_ns);
+    }
+
+    template <typename T>
+    void bench_all() {
+        bench<T>("exp", kernels::exp<T>, [](const T v) { return std::exp(v); }, -5, 5);
+        bench<T>("log", kernels::log<T>, [](const T v) { return std::log(v); }, 1e-3, 1e3);
+        bench<T>("tanh", kernels::tanh<T>, [](const T v) { return std::tanh(v); }, -5, 5);
+        bench<T>("sin", kernels::sin<T>, [](const T v) { return std::sin(v); }, -5, 5);
+        bench<T>("cos", kernels::cos<T>, [](const T v) { return std::cos(v); }, -5, 5);
+    }
+
+}
+
+int main() {
+    std::printf("kernels: %s, %zu elements x %d repeats\n", kernels::isa(), length, repeats);
+    bench_all<double>();
+    bench_all<float>();
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "autodiff/kernels/Kernels.h"
+
+// Numerically stable cross-entropy sums over raw logits, shared by the fused
+// autodiff nodes and by the losses' graph-free value(). Both return the sum
+// over samples and, when `residual` is non-empty, write d(sum)/d(logit) into it.
+
+namespace autodiff::kernels {
+
+    // sum_i max(z_i, 0) - z_i y_i + log1p(exp(-|z_i|)); residual_i = sigmoid(z_i) - y_i.
+    template <Scalar T>
+    accumulate_t<T> sigmoid_cross_entropy(const std::span<const T> logits,
+                                          const std::span<const T> targets,
+                                          const std::span<T> residual = {}) {
+        if (logits.size() != targets.size() || (!residual.empty() && residual.size() != logits.size())) {
+            throw std::invalid_argument("sigmoid_cross_entropy: logits, targets and residual differ in size");
+        }
+        thread_local std::vector<T> e;
+        e.resize(logits.size());
+        for (size_t i = 0; i < logits.size(); ++i) {
+            e[i] = -std::fabs(logits[i]);
+        }
+        exp<T>(e, e);
+
+        accumulate_t<T> total = 0;
+        for (size_t i = 0; i < logits.size(); ++i) {
+            const accumulate_t<T> z = logits[i];
+            const accumulate_t<T> y = targets[i];
+            const accumulate_t<T> ez = e[i];
+            total += std::max<accumulate_t<T>>(z, 0) - z * y + std::log1p(ez);
+            if (!residual.empty()) {
+                const accumulate_t<T> p = z >= 0 ? 1 / (1 + ez) : ez / (1 + ez);
+                residual[i] = static_cast<T>(p - y);
+            }
+        }
+        return total;
+    }
+
+    // Logits are n rows of k class scores (row-major) and labels hold class
+    // indices 0..k-1. sum_i log(sum_j exp(z_ij - m_i)) - (z_i,label - m_i) with
+    // m_i the row maximum; residual_ij = softmax(z_i)_j - [j == label_i].
+    template <Scalar T>
+    accumulate_t<T> softmax_cross_entropy(const std::span<const T> logits,
+                                          const std::span<const T> labels,
+                                          const size_t n_classes,
+                                          const std::span<T> residual = {}) {
+        if (n_classes == 0 || logits.size() != labels.size() * n_classes) {
+            throw std::invalid_argument("softmax_cross_entropy: expected one row of n_classes logits per label");
+        }
+        if (!residual.empty() && residual.size() != logits.size()) {
+            throw std::invalid_argument("softmax_cross_entropy: residual and logits differ in size");
+        }
+        thread_local std::vector<T> e;
+        thread_local std::vector<T> label_logit;
+        e.resize(logits.size());
+        label_logit.resize(labels.size());
+
+        for (size_t i = 0; i < labels.size(); ++i) {
+            const T label = labels[i];
+            if (!(label >= 0 && label < static_cast<T>(n_classes)) || label != std::floor(label)) {
+                throw std::invalid_argument("softmax_cross_entropy: label is not a class index");
+            }
+            const T* row = logits.data() + i * n_classes;
+            T max = row[0];
+            for (size_t j = 1; j < n_classes; ++j) {
+                max = std::max(max, row[j]);
+            }
+            for (size_t j = 0; j < n_classes; ++j) {
+                e[i * n_classes + j] = row[j] - max;
+            }
+            label_logit[i] = row[static_cast<size_t>(label)] - max;
+        }
+        exp<T>(e, e);
+
+        accumulate_t<T> total = 0;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            const T* row = e.data() + i * n_classes;
+            accumulate_t<T> denominator = 0;
+            for (size_t j = 0; j < n_classes; ++j) {
+                denominator += row[j];
+            }
+            total += std::log(denominator) - label_logit[i];
+
+            if (!residual.empty()) {
+                const auto label = static_cast<size_t>(labels[i]);
+                T* out = residual.data() + i * n_classes;
+                for (size_t j = 0; j < n_classes; ++j) {
+                    out[j] = static_cast<T>(row[j] / denominator - (j == label ? 1 : 0));
+                }
+            }
+        }
+        return total;
+    }
+
+}
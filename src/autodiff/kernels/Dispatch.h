@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+
+// Function tables shared by the kernel implementations; not part of the public API.
+
+namespace autodiff::kernels::detail {
+
+    template <typename T>
+    struct Table {
+        using Fn = void (*)(const T*, T*, size_t);
+        Fn exp;
+        Fn log;
+        Fn tanh;
+        Fn sin;
+        Fn cos;
+        const char* isa;
+    };
+
+    // AVX2 + FMA tables from KernelsAvx2.cpp; nullptr when that file was built
+    // for a target without them.
+    template <typename T> const Table<T>* avx2_table();
+    template <> const Table<float>* avx2_table<float>();
+    template <> const Table<double>* avx2_table<double>();
+
+}
@@ -0,0 +1,206 @@
+#include "Kernels.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include "Dispatch.h"
+#include "Transcendental.h"
+
+namespace autodiff::kernels {
+
+    namespace {
+
+        template <typename T>
+        struct Bits;
+
+        template <>
+        struct Bits<double> {
+            using type = std::uint64_t;
+            static constexpr int mantissa_bits = 52;
+            static constexpr type exponent_mask = 0x7ff;
+            static constexpr type bias = 1023;
+        };
+
+        template <>
+        struct Bits<float> {
+            using type = std::uint32_t;
+            static constexpr int mantissa_bits = 23;
+            static constexpr type exponent_mask = 0xff;
+            static constexpr type bias = 127;
+        };
+
+        // One-lane policy for approx::*; the portable fallback.
+        template <typename T>
+        struct ScalarOps {
+            using scalar = T;
+            using vec = T;
+            using mask = bool;
+            using B = Bits<T>;
+            using U = typename B::type;
+            static constexpr size_t width = 1;
+
+            static vec set(const double c) { return static_cast<T>(c); }
+            static vec load(const T* p) { return *p; }
+            static void store(T* p, const vec v) { *p = v; }
+
+            static vec add(const vec a, const vec b) { return a + b; }
+            static vec sub(const vec a, const vec b) { return a - b; }
+            static vec mul(const vec a, const vec b) { return a * b; }
+            static vec div(const vec a, const vec b) { return a / b; }
+            // Fused like the AVX2 path: the Cody-Waite trig reduction relies on a
+            // single rounding of k * pio2 + x, which a * b + c does not give.
+            static vec fma(const vec a, const vec b, const vec c) { return std::fma(a, b, c); }
+
+            static vec round(const vec a) { return std::nearbyint(a); }
+            static vec floor(const vec a) { return std::floor(a); }
+            static vec abs(const vec a) { return std::fabs(a); }
+            static vec min(const vec a, const vec b) { return b < a ? b : a; }
+            static vec max(const vec a, const vec b) { return a < b ? b : a; }
+            static vec copysign(const vec a, const vec b) { return std::copysign(a, b); }
+            static vec nan() { return std::numeric_limits<T>::quiet_NaN(); }
+
+            static mask lt(const vec a, const vec b) { return a < b; }
+            static mask gt(const vec a, const vec b) { return a > b; }
+            static mask ge(const vec a, const vec b) { return a >= b; }
+            static mask eq(const vec a, const vec b) { return a == b; }
+            static mask ne(const vec a, const vec b) { return a != b; }
+            static mask isnan(const vec a) { return a != a; }
+            static vec select(const mask m, const vec a, const vec b) { return m ? a : b; }
+            static bool any(const mask m) { return m; }
+
+            // 2^k for integral k inside the normal exponent range.
+            static vec pow2i(const vec k) {
+                const auto biased = static_cast<U>(static_cast<std::int64_t>(k) + static_cast<std::int64_t>(B::bias));
+                return std::bit_cast<T>(static_cast<U>(biased << B::mantissa_bits));
+            }
+
+            // x = mantissa(x) * 2^exponent(x) with mantissa in [1, 2), for normal x.
+            static vec exponent(const vec x) {
+                const U bits = std::bit_cast<U>(x);
+                const auto biased = static_cast<std::int64_t>((bits >> B::mantissa_bits) & B::exponent_mask);
+                return static_cast<T>(biased - static_cast<std::int64_t>(B::bias));
+            }
+
+            static vec mantissa(const vec x) {
+                constexpr U fraction = (U{1} << B::mantissa_bits) - 1;
+                const U bits = (std::bit_cast<U>(x) & fraction) | (B::bias << B::mantissa_bits);
+                return std::bit_cast<T>(bits);
+            }
+        };
+
+        template <typename T>
+        void scalar_exp(const T* in, T* out, const size_t n) {
+            approx::apply<ScalarOps<T>>(in, out, n, approx::exp<ScalarOps<T>>);
+        }
+
+        template <typename T>
+        void scalar_log(const T* in, T* out, const size_t n) {
+            approx::apply<ScalarOps<T>>(in, out, n, approx::log<ScalarOps<T>>);
+        }
+
+        template <typename T>
+        void scalar_tanh(const T* in, T* out, const size_t n) {
+            approx::apply<ScalarOps<T>>(in, out, n, approx::tanh<ScalarOps<T>>);
+        }
+
+        template <typename T>
+        void scalar_sin(const T* in, T* out, const size_t n) {
+            approx::apply_trig<ScalarOps<T>>(in, out, n, approx::sin<ScalarOps<T>>,
+                                             [](const T x) { return std::sin(x); });
+        }
+
+        template <typename T>
+        void scalar_cos(const T* in, T* out, const size_t n) {
+            approx::apply_trig<ScalarOps<T>>(in, out, n, approx::cos<ScalarOps<T>>,
+                                             [](const T x) { return std::cos(x); });
+        }
+
+        template <typename T>
+        constexpr detail::Table<T> scalar_table = {
+            scalar_exp<T>, scalar_log<T>, scalar_tanh<T>, scalar_sin<T>, scalar_cos<T>, "scalar",
+        };
+
+        bool avx2_supported() {
+#if defined(__x86_64__) && defined(__GNUC__)
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        }
+
+        template <typename T>
+        const detail::Table<T>* select() {
+            const char* forced = std::getenv("AUTODIFF_KERNELS");
+            if (forced && std::strcmp(forced, "scalar") == 0) return &scalar_table<T>;
+            if (avx2_supported()) {
+                if (const auto* table = detail::avx2_table<T>()) return table;
+            }
+            return &scalar_table<T>;
+        }
+
+        template <typename T>
+        const detail::Table<T>& table() {
+            static const detail::Table<T>* selected = select<T>();
+            return *selected;
+        }
+
+        template <typename T>
+        void check_sizes(const std::span<const T> in, const std::span<T> out) {
+            if (in.size() != out.size()) {
+                throw std::invalid_argument("kernels: input and output sizes differ");
+            }
+        }
+
+    }
+
+    template <Scalar T>
+    void exp(const std::span<const T> in, const std::span<T> out) {
+        check_sizes(in, out);
+        table<T>().exp(in.data(), out.data(), in.size());
+    }
+
+    template <Scalar T>
+    void log(const std::span<const T> in, const std::span<T> out) {
+        check_sizes(in, out);
+        table<T>().log(in.data(), out.data(), in.size());
+    }
+
+    template <Scalar T>
+    void tanh(const std::span<const T> in, const std::span<T> out) {
+        check_sizes(in, out);
+        table<T>().tanh(in.data(), out.data(), in.size());
+    }
+
+    template <Scalar T>
+    void sin(const std::span<const T> in, const std::span<T> out) {
+        check_sizes(in, out);
+        table<T>().sin(in.data(), out.data(), in.size());
+    }
+
+    template <Scalar T>
+    void cos(const std::span<const T> in, const std::span<T> out) {
+        check_sizes(in, out);
+        table<T>().cos(in.data(), out.data(), in.size());
+    }
+
+    const char* isa() {
+        return table<double>().isa;
+    }
+
+#define KERNELS_INSTANTIATE(T) \
+    template void exp<T>(std::span<const T>, std::span<T>); \
+    template void log<T>(std::span<const T>, std::span<T>); \
+    template void tanh<T>(std::span<const T>, std::span<T>); \
+    template void sin<T>(std::span<const T>, std::span<T>); \
+    template void cos<T>(std::span<const T>, std::span<T>);
+
+    KERNELS_INSTANTIATE(float)
+    KERNELS_INSTANTIATE(double)
+
+#undef KERNELS_INSTANTIATE
+
+}
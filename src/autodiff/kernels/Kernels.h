@@ -0,0 +1,22 @@
+#pragma once
+#include <span>
+#include "autodiff/precision/Precision.h"
+
+// Batched elementwise transcendental functions. out[i] = f(in[i]); in and out
+// must have the same size and may be the same span. The implementation is
+// picked once per process from the best instruction set the CPU supports
+// (AVX2 + FMA, otherwise portable scalar code); set AUTODIFF_KERNELS=scalar to
+// force the portable path. Error bounds are listed in Transcendental.h.
+
+namespace autodiff::kernels {
+
+    template <Scalar T> void exp(std::span<const T> in, std::span<T> out);
+    template <Scalar T> void log(std::span<const T> in, std::span<T> out);
+    template <Scalar T> void tanh(std::span<const T> in, std::span<T> out);
+    template <Scalar T> void sin(std::span<const T> in, std::span<T> out);
+    template <Scalar T> void cos(std::span<const T> in, std::span<T> out);
+
+    // Name of the selected implementation: "avx2" or "scalar".
+    const char* isa();
+
+}
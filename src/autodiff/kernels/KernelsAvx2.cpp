@@ -0,0 +1,211 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "Dispatch.h"
+
+// AVX2 + FMA implementations. Only this file is compiled for those extensions,
+// and Kernels.cpp calls into it only after checking the CPU, so the library
+// still runs on older x86-64 machines.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+// Included after the target switch so the shared algorithms are compiled for AVX2 here.
+#include "Transcendental.h"
+
+namespace autodiff::kernels {
+
+    namespace {
+
+        struct Avx2Double {
+            using scalar = double;
+            using vec = __m256d;
+            using mask = __m256d;
+            static constexpr size_t width = 4;
+
+            static vec set(const double c) { return _mm256_set1_pd(c); }
+            static vec load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, const vec v) { _mm256_storeu_pd(p, v); }
+
+            static vec add(const vec a, const vec b) { return _mm256_add_pd(a, b); }
+            static vec sub(const vec a, const vec b) { return _mm256_sub_pd(a, b); }
+            static vec mul(const vec a, const vec b) { return _mm256_mul_pd(a, b); }
+            static vec div(const vec a, const vec b) { return _mm256_div_pd(a, b); }
+            static vec fma(const vec a, const vec b, const vec c) { return _mm256_fmadd_pd(a, b, c); }
+
+            static vec round(const vec a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            static vec floor(const vec a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            static vec abs(const vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+            static vec min(const vec a, const vec b) { return _mm256_min_pd(a, b); }
+            static vec max(const vec a, const vec b) { return _mm256_max_pd(a, b); }
+            static vec copysign(const vec a, const vec b) {
+                const vec sign = _mm256_set1_pd(-0.0);
+                return _mm256_or_pd(_mm256_andnot_pd(sign, a), _mm256_and_pd(sign, b));
+            }
+            static vec nan() { return _mm256_set1_pd(NAN); }
+
+            static mask lt(const vec a, const vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+            static mask gt(const vec a, const vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+            static mask ge(const vec a, const vec b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+            static mask eq(const vec a, const vec b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+            static mask ne(const vec a, const vec b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+            static mask isnan(const vec a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+            static vec select(const mask m, const vec a, const vec b) { return _mm256_blendv_pd(b, a, m); }
+            static bool any(const mask m) { return _mm256_movemask_pd(m) != 0; }
+
+            // Adding 2^52 + 1023 leaves k + 1023 in the low mantissa bits, which
+            // the shift moves into the exponent field.
+            static vec pow2i(const vec k) {
+                const vec biased = _mm256_add_pd(k, _mm256_set1_pd(4503599627371519.0)); // 2^52 + 1023
+                return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+            }
+
+            static vec exponent(const vec x) {
+                const __m256i bits = _mm256_srli_epi64(_mm256_castpd_si256(x), 52);
+                const __m256i biased = _mm256_and_si256(bits, _mm256_set1_epi64x(0x7ff));
+                // Integer -> double through the 2^52 exponent, then remove the bias.
+                const vec as_double = _mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0))));
+                return _mm256_sub_pd(as_double, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+            }
+
+            static vec mantissa(const vec x) {
+                const __m256i fraction = _mm256_and_si256(_mm256_castpd_si256(x), _mm256_set1_epi64x(0x000fffffffffffffLL));
+                return _mm256_castsi256_pd(_mm256_or_si256(fraction, _mm256_set1_epi64x(0x3ff0000000000000LL)));
+            }
+        };
+
+        struct Avx2Float {
+            using scalar = float;
+            using vec = __m256;
+            using mask = __m256;
+            static constexpr size_t width = 8;
+
+            static vec set(const double c) { return _mm256_set1_ps(static_cast<float>(c)); }
+            static vec load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, const vec v) { _mm256_storeu_ps(p, v); }
+
+            static vec add(const vec a, const vec b) { return _mm256_add_ps(a, b); }
+            static vec sub(const vec a, const vec b) { return _mm256_sub_ps(a, b); }
+            static vec mul(const vec a, const vec b) { return _mm256_mul_ps(a, b); }
+            static vec div(const vec a, const vec b) { return _mm256_div_ps(a, b); }
+            static vec fma(const vec a, const vec b, const vec c) { return _mm256_fmadd_ps(a, b, c); }
+
+            static vec round(const vec a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            static vec floor(const vec a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            static vec abs(const vec a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static vec min(const vec a, const vec b) { return _mm256_min_ps(a, b); }
+            static vec max(const vec a, const vec b) { return _mm256_max_ps(a, b); }
+            static vec copysign(const vec a, const vec b) {
+                const vec sign = _mm256_set1_ps(-0.0f);
+                return _mm256_or_ps(_mm256_andnot_ps(sign, a), _mm256_and_ps(sign, b));
+            }
+            static vec nan() { return _mm256_set1_ps(NAN); }
+
+            static mask lt(const vec a, const vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static mask gt(const vec a, const vec b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+            static mask ge(const vec a, const vec b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+            static mask eq(const vec a, const vec b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+            static mask ne(const vec a, const vec b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+            static mask isnan(const vec a) { return _mm256_cmp_ps(a, a, _CMP_UNORD_Q); }
+            static vec select(const mask m, const vec a, const vec b) { return _mm256_blendv_ps(b, a, m); }
+            static bool any(const mask m) { return _mm256_movemask_ps(m) != 0; }
+
+            static vec pow2i(const vec k) {
+                const __m256i biased = _mm256_add_epi32(_mm256_cvtps_epi32(k), _mm256_set1_epi32(127));
+                return _mm256_castsi256_ps(_mm256_slli_epi32(biased, 23));
+            }
+
+            static vec exponent(const vec x) {
+                const __m256i bits = _mm256_srli_epi32(_mm256_castps_si256(x), 23);
+                const __m256i biased = _mm256_and_si256(bits, _mm256_set1_epi32(0xff));
+                return _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(127)));
+            }
+
+            static vec mantissa(const vec x) {
+                const __m256i fraction = _mm256_and_si256(_mm256_castps_si256(x), _mm256_set1_epi32(0x007fffff));
+                return _mm256_castsi256_ps(_mm256_or_si256(fraction, _mm256_set1_epi32(0x3f800000)));
+            }
+        };
+
+        template <typename V>
+        void avx2_exp(const typename V::scalar* in, typename V::scalar* out, const size_t n) {
+            approx::apply<V>(in, out, n, approx::exp<V>);
+        }
+
+        template <typename V>
+        void avx2_log(const typename V::scalar* in, typename V::scalar* out, const size_t n) {
+            approx::apply<V>(in, out, n, approx::log<V>);
+        }
+
+        template <typename V>
+        void avx2_tanh(const typename V::scalar* in, typename V::scalar* out, const size_t n) {
+            approx::apply<V>(in, out, n, approx::tanh<V>);
+        }
+
+        double libm_sin(const double x) { return ::sin(x); }
+        double libm_cos(const double x) { return ::cos(x); }
+        float libm_sin(const float x) { return ::sinf(x); }
+        float libm_cos(const float x) { return ::cosf(x); }
+
+        template <typename V>
+        void avx2_sin(const typename V::scalar* in, typename V::scalar* out, const size_t n) {
+            using S = typename V::scalar;
+            approx::apply_trig<V>(in, out, n, approx::sin<V>, [](const S x) { return libm_sin(x); });
+        }
+
+        template <typename V>
+        void avx2_cos(const typename V::scalar* in, typename V::scalar* out, const size_t n) {
+            using S = typename V::scalar;
+            approx::apply_trig<V>(in, out, n, approx::cos<V>, [](const S x) { return libm_cos(x); });
+        }
+
+        template <typename V>
+        constexpr detail::Table<typename V::scalar> avx2 = {
+            avx2_exp<V>, avx2_log<V>, avx2_tanh<V>, avx2_sin<V>, avx2_cos<V>, "avx2",
+        };
+
+    }
+
+    template <>
+    const detail::Table<float>* detail::avx2_table<float>() {
+        return &avx2<Avx2Float>;
+    }
+
+    template <>
+    const detail::Table<double>* detail::avx2_table<double>() {
+        return &avx2<Avx2Double>;
+    }
+
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#else
+
+namespace autodiff::kernels {
+
+    template <>
+    const detail::Table<float>* detail::avx2_table<float>() {
+        return nullptr;
+    }
+
+    template <>
+    const detail::Table<double>* detail::avx2_table<double>() {
+        return nullptr;
+    }
+
+}
+
+#endif
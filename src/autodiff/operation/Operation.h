@@ -4,11 +4,14 @@
 
 namespace autodiff {
 
+    template <Scalar T>
     class Operation {
     public:
+        using Accum = accumulate_t<T>;
+
         virtual ~Operation() = default;
-        virtual void backward(double grad_output) = 0;
-        virtual std::vector<std::shared_ptr<Variable>> get_inputs() = 0;
+        virtual void backward(Accum grad_output) = 0;
+        virtual std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() = 0;
     };
 
 }
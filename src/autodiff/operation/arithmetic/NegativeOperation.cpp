@@ -2,23 +2,26 @@
 
 namespace autodiff {
 
-    class NegativeOperation final : public Operation {
+    template <Scalar T>
+    class NegativeOperation final : public Operation<T> {
     public:
-        explicit NegativeOperation(const std::shared_ptr<Variable> &input) : in(input) {}
+        using Accum = typename Operation<T>::Accum;
 
-        void backward(const double grad_output) override {
+        explicit NegativeOperation(const std::shared_ptr<BasicVariable<T>> &input) : in(input) {}
+
+        void backward(const Accum grad_output) override {
             if (in->requires_grad()) {
-                constexpr double local_grad = -1.0;
+                constexpr Accum local_grad = -1.0;
                 in->grad_ += grad_output * local_grad;
             }
         }
 
-        std::vector<std::shared_ptr<Variable>> get_inputs() override {
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
             return {in};
         }
 
     private:
-        std::shared_ptr<Variable> in;
+        std::shared_ptr<BasicVariable<T>> in;
     };
 
 }
@@ -0,0 +1,28 @@
+#include "autodiff/operation/Operation.h"
+
+namespace autodiff {
+
+    template <Scalar T>
+    class SumOperation final : public Operation<T> {
+    public:
+        using Accum = typename Operation<T>::Accum;
+
+        explicit SumOperation(std::vector<std::shared_ptr<BasicVariable<T>>> terms) : terms(std::move(terms)) {}
+
+        void backward(const Accum grad_output) override {
+            for (const auto& term : terms) {
+                if (term->requires_grad()) {
+                    term->grad_ += grad_output;
+                }
+            }
+        }
+
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
+            return terms;
+        }
+
+    private:
+        std::vector<std::shared_ptr<BasicVariable<T>>> terms;
+    };
+
+}
@@ -0,0 +1,36 @@
+#include "autodiff/operation/Operation.h"
+
+namespace autodiff {
+
+    // Fused cross-entropy over a batch of logits. The forward pass leaves
+    // d(loss)/d(logit) for every input in `residual`, so backward is a single
+    // O(n k) sweep instead of a walk over per-sample exp/log/divide nodes.
+    template <Scalar T>
+    class CrossEntropyOperation final : public Operation<T> {
+    public:
+        using Accum = typename Operation<T>::Accum;
+
+        CrossEntropyOperation(std::vector<std::shared_ptr<BasicVariable<T>>> logits,
+                              std::vector<T> residual, const Accum scale)
+            : logits(std::move(logits)), residual(std::move(residual)), scale(scale) {}
+
+        void backward(const Accum grad_output) override {
+            const Accum factor = grad_output * scale;
+            for (size_t i = 0; i < logits.size(); ++i) {
+                if (logits[i]->requires_grad()) {
+                    logits[i]->grad_ += factor * residual[i];
+                }
+            }
+        }
+
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
+            return logits;
+        }
+
+    private:
+        std::vector<std::shared_ptr<BasicVariable<T>>> logits;
+        std::vector<T> residual;
+        Accum scale;
+    };
+
+}
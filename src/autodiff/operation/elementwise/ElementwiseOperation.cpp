@@ -0,0 +1,30 @@
+#include "autodiff/operation/Operation.h"
+
+namespace autodiff {
+
+    // Output of a batched elementwise function; the local derivative is
+    // computed together with the forward values and stored here.
+    template <Scalar T>
+    class ElementwiseOperation final : public Operation<T> {
+    public:
+        using Accum = typename Operation<T>::Accum;
+
+        ElementwiseOperation(const std::shared_ptr<BasicVariable<T>>& input, const T local_grad)
+            : in(input), local_grad(local_grad) {}
+
+        void backward(const Accum grad_output) override {
+            if (in->requires_grad()) {
+                in->grad_ += grad_output * local_grad;
+            }
+        }
+
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
+            return {in};
+        }
+
+    private:
+        std::shared_ptr<BasicVariable<T>> in;
+        T local_grad;
+    };
+
+}
@@ -1,26 +1,30 @@
 #include "autodiff/operation/Operation.h"
+#include <cmath>
 
 namespace autodiff {
 
-    class ExponentialOperation final : public Operation {
+    template <Scalar T>
+    class ExponentialOperation final : public Operation<T> {
     public:
-        explicit ExponentialOperation(const std::shared_ptr<Variable>& input)
+        using Accum = typename Operation<T>::Accum;
+
+        explicit ExponentialOperation(const std::shared_ptr<BasicVariable<T>>& input)
             : in(input), in_val(input->value()) {}
 
-        void backward(const double grad_output) override {
+        void backward(const Accum grad_output) override {
             if (in->requires_grad()) {
-                const double local_grad = std::exp(in_val);
+                const Accum local_grad = std::exp(in_val);
                 in->grad_ += grad_output * local_grad;
             }
         }
 
-        std::vector<std::shared_ptr<Variable>> get_inputs() override {
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
             return {in};
         }
 
     private:
-        std::shared_ptr<Variable> in;
-        double in_val;
+        std::shared_ptr<BasicVariable<T>> in;
+        T in_val;
     };
 
 }
\ No newline at end of file
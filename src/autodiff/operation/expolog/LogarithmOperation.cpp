@@ -2,25 +2,28 @@
 
 namespace autodiff {
 
-    class LogarithmOperation final : public Operation {
+    template <Scalar T>
+    class LogarithmOperation final : public Operation<T> {
     public:
-        explicit LogarithmOperation(const std::shared_ptr<Variable>& arg)
+        using Accum = typename Operation<T>::Accum;
+
+        explicit LogarithmOperation(const std::shared_ptr<BasicVariable<T>>& arg)
             : arg(arg), arg_val(arg->value()) {}
 
-        void backward(const double grad_output) override {
+        void backward(const Accum grad_output) override {
             if (arg->requires_grad()) {
-                const double local_grad = 1.0 / arg_val;
+                const Accum local_grad = 1.0 / arg_val;
                 arg->grad_ += grad_output * local_grad;
             }
         }
 
-        std::vector<std::shared_ptr<Variable>> get_inputs() override {
+        std::vector<std::shared_ptr<BasicVariable<T>>> get_inputs() override {
             return {arg};
         }
 
     private:
-        std::shared_ptr<Variable> arg;
-        double arg_val;
+        std::shared_ptr<BasicVariable<T>> arg;
+        T arg_val;
     };
 
 }
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+#include <concepts>
+#include <type_traits>
+
+namespace autodiff {
+
+    // Scalar types the engine is instantiated for (float and double).
+    template <typename T>
+    concept Scalar = std::floating_point<T>;
+
+    // Type used for gradients, reductions and master weights. Narrow types
+    // accumulate in double so that float storage keeps double-precision sums.
+    template <Scalar T>
+    using accumulate_t = std::conditional_t<(sizeof(T) < sizeof(double)), double, T>;
+
+}
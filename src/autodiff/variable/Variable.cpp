@@ -1,40 +1,52 @@
 #include "Variable.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 #include <ranges>
+#include <span>
+#include "autodiff/kernels/CrossEntropy.h"
+#include "autodiff/kernels/Kernels.h"
 #include "autodiff/operation/Operation.h"
 #include "autodiff/operation/arithmetic/AddOperation.cpp"
 #include "autodiff/operation/arithmetic/SubtractOperation.cpp"
 #include "autodiff/operation/arithmetic/MultiplyOperation.cpp"
 #include "autodiff/operation/arithmetic/DivideOperation.cpp"
 #include "autodiff/operation/arithmetic/NegativeOperation.cpp"
+#include "autodiff/operation/arithmetic/SumOperation.cpp"
 #include "autodiff/operation/expolog/LogarithmOperation.cpp"
 #include "autodiff/operation/expolog/ExponentialOperation.cpp"
 #include "autodiff/operation/expolog/PowerOperation.cpp"
 #include "autodiff/operation/trigonometric/SineOperation.cpp"
 #include "autodiff/operation/trigonometric/CosineOperation.cpp"
 #include "autodiff/operation/hyperbolic/TanhOperation.cpp"
+#include "autodiff/operation/elementwise/ElementwiseOperation.cpp"
+#include "autodiff/operation/crossentropy/CrossEntropyOperation.cpp"
 
 namespace autodiff {
 
-    Variable::Variable(const double value, const bool requires_grad)
+    template <Scalar T>
+    BasicVariable<T>::BasicVariable(const T value, const bool requires_grad)
         : value_(value), grad_(0.0), requires_grad_(requires_grad), grad_fn_(nullptr) {}
 
-    Variable::Variable(const double value, const bool requires_grad, std::shared_ptr<Operation> grad_fn)
+    template <Scalar T>
+    BasicVariable<T>::BasicVariable(const T value, const bool requires_grad, std::shared_ptr<Operation<T>> grad_fn)
         : value_(value), grad_(0.0), requires_grad_(requires_grad), grad_fn_(std::move(grad_fn)) {}
 
-    std::shared_ptr<Variable> Variable::create(double value, bool requires_grad) {
-        return std::shared_ptr<Variable>(new Variable(value, requires_grad));
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::create(T value, bool requires_grad) {
+        return std::shared_ptr<BasicVariable>(new BasicVariable(value, requires_grad));
     }
 
-    std::shared_ptr<Variable> Variable::create(double value, bool requires_grad, std::shared_ptr<Operation> grad_fn) {
-        return std::shared_ptr<Variable>(new Variable(value, requires_grad, std::move(grad_fn)));
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::create(T value, bool requires_grad, std::shared_ptr<Operation<T>> grad_fn) {
+        return std::shared_ptr<BasicVariable>(new BasicVariable(value, requires_grad, std::move(grad_fn)));
     }
 
-    void Variable::backward() {
+    template <Scalar T>
+    void BasicVariable<T>::backward() {
         grad_ = 1.0;
-        std::vector<std::shared_ptr<Variable>> sorted;
-        std::set<std::shared_ptr<Variable>> visited;
+        std::vector<std::shared_ptr<BasicVariable>> sorted;
+        std::set<std::shared_ptr<BasicVariable>> visited;
         topological_sort(sorted, visited);
 
         for (const auto& it : std::ranges::reverse_view(sorted)) {
@@ -44,11 +56,12 @@ namespace autodiff {
         }
     }
 
-    void Variable::topological_sort(std::vector<std::shared_ptr<Variable>>& sorted,
-                                   std::set<std::shared_ptr<Variable>>& visited) {
-        if (visited.contains(shared_from_this())) return;
+    template <Scalar T>
+    void BasicVariable<T>::topological_sort(std::vector<std::shared_ptr<BasicVariable>>& sorted,
+                                            std::set<std::shared_ptr<BasicVariable>>& visited) {
+        if (visited.contains(this->shared_from_this())) return;
 
-        visited.insert(shared_from_this());
+        visited.insert(this->shared_from_this());
 
         if (grad_fn_) {
             for (const auto& input : grad_fn_->get_inputs()) {
@@ -56,15 +69,16 @@ namespace autodiff {
             }
         }
 
-        sorted.push_back(shared_from_this());
+        sorted.push_back(this->shared_from_this());
     }
 
-    std::shared_ptr<Variable> Variable::operator+(const std::shared_ptr<Variable>& other) {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::operator+(const std::shared_ptr<BasicVariable>& other) {
         auto result = create(value_ + other->value_, requires_grad_ || other->requires_grad_);
 
         if (requires_grad_ || other->requires_grad_) {
-            result->grad_fn_ = std::make_shared<AddOperation>(
-                shared_from_this(),
+            result->grad_fn_ = std::make_shared<AddOperation<T>>(
+                this->shared_from_this(),
                 other
             );
         }
@@ -72,12 +86,13 @@ namespace autodiff {
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::operator-(const std::shared_ptr<Variable>& other) {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::operator-(const std::shared_ptr<BasicVariable>& other) {
         auto result = create(value_ - other->value_, requires_grad_ || other->requires_grad_);
 
         if (requires_grad_ || other->requires_grad_) {
-            result->grad_fn_ = std::make_shared<SubtractOperation>(
-                shared_from_this(),
+            result->grad_fn_ = std::make_shared<SubtractOperation<T>>(
+                this->shared_from_this(),
                 other
             );
         }
@@ -85,12 +100,13 @@ namespace autodiff {
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::operator*(const std::shared_ptr<Variable>& other) {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::operator*(const std::shared_ptr<BasicVariable>& other) {
         auto result = create(value_ * other->value_, requires_grad_ || other->requires_grad_);
 
         if (requires_grad_ || other->requires_grad_) {
-            result->grad_fn_ = std::make_shared<MultiplyOperation>(
-                shared_from_this(),
+            result->grad_fn_ = std::make_shared<MultiplyOperation<T>>(
+                this->shared_from_this(),
                 other
             );
         }
@@ -98,12 +114,13 @@ namespace autodiff {
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::operator/(const std::shared_ptr<Variable>& other) {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::operator/(const std::shared_ptr<BasicVariable>& other) {
         auto result = create(value_ / other->value_, requires_grad_ || other->requires_grad_);
 
         if (requires_grad_ || other->requires_grad_) {
-            result->grad_fn_ = std::make_shared<DivideOperation>(
-                shared_from_this(),
+            result->grad_fn_ = std::make_shared<DivideOperation<T>>(
+                this->shared_from_this(),
                 other
             );
         }
@@ -111,24 +128,26 @@ namespace autodiff {
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::operator-() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::operator-() {
         auto result = create(-value_, requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<NegativeOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<NegativeOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::pow(const std::shared_ptr<Variable>& other) {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::pow(const std::shared_ptr<BasicVariable>& other) {
         auto result = create(std::pow(value_, other->value_), requires_grad_ || other->requires_grad_);
 
         if (requires_grad_ || other->requires_grad_) {
-            result->grad_fn_ = std::make_shared<PowerOperation>(
-                shared_from_this(),
+            result->grad_fn_ = std::make_shared<PowerOperation<T>>(
+                this->shared_from_this(),
                 other
             );
         }
@@ -136,142 +155,323 @@ namespace autodiff {
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::log() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::log() {
         auto result = create(std::log(value_), requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<LogarithmOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<LogarithmOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::exp() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::exp() {
         auto result = create(std::exp(value_), requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<ExponentialOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<ExponentialOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::sin() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::sin() {
         auto result = create(std::sin(value_), requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<SineOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<SineOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::cos() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::cos() {
         auto result = create(std::cos(value_), requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<CosineOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<CosineOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    std::shared_ptr<Variable> Variable::tanh() {
+    template <Scalar T>
+    std::shared_ptr<BasicVariable<T>> BasicVariable<T>::tanh() {
         auto result = create(std::tanh(value_), requires_grad_);
 
         if (requires_grad_) {
-            result->grad_fn_ = std::make_shared<TanhOperation>(
-                shared_from_this()
+            result->grad_fn_ = std::make_shared<TanhOperation<T>>(
+                this->shared_from_this()
             );
         }
 
         return result;
     }
 
-    void Variable::print() const {
+    template <Scalar T>
+    void BasicVariable<T>::print() const {
         std::cout << "Variable(value=" << value_ << ", grad=" << grad_ << ")" << std::endl;
     }
 
-    std::shared_ptr<Variable> operator+(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs) {
+    template <Scalar T>
+    VariablePtr<T> operator+(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs) {
         return lhs->operator+(rhs);
     }
 
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs) {
+    template <Scalar T>
+    VariablePtr<T> operator-(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs) {
         return lhs->operator-(rhs);
     }
 
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs) {
+    template <Scalar T>
+    VariablePtr<T> operator-(const VariablePtr<T>& lhs) {
         return lhs->operator-();
     }
 
-    std::shared_ptr<Variable> operator*(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs) {
+    template <Scalar T>
+    VariablePtr<T> operator*(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs) {
         return lhs->operator*(rhs);
     }
 
-    std::shared_ptr<Variable> operator/(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs) {
+    template <Scalar T>
+    VariablePtr<T> operator/(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs) {
         return lhs->operator/(rhs);
     }
 
-    std::shared_ptr<Variable> pow(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs) {
+    template <Scalar T>
+    VariablePtr<T> pow(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs) {
         return lhs->pow(rhs);
     }
 
-    std::shared_ptr<Variable> operator+(const std::shared_ptr<Variable>& lhs, const double rhs) {
-        const auto rhs_var = Variable::create(rhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator+(const VariablePtr<T>& lhs, const std::type_identity_t<T> rhs) {
+        const auto rhs_var = BasicVariable<T>::create(rhs, false);
         return lhs->operator+(rhs_var);
     }
 
-    std::shared_ptr<Variable> operator+(const double lhs, const std::shared_ptr<Variable>& rhs) {
-        const auto lhs_var = Variable::create(lhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator+(const std::type_identity_t<T> lhs, const VariablePtr<T>& rhs) {
+        const auto lhs_var = BasicVariable<T>::create(lhs, false);
         return lhs_var->operator+(rhs);
     }
 
-    std::shared_ptr<Variable> operator*(const std::shared_ptr<Variable>& lhs, const double rhs) {
-        const auto rhs_var = Variable::create(rhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator*(const VariablePtr<T>& lhs, const std::type_identity_t<T> rhs) {
+        const auto rhs_var = BasicVariable<T>::create(rhs, false);
         return lhs->operator*(rhs_var);
     }
 
-    std::shared_ptr<Variable> operator*(const double lhs, const std::shared_ptr<Variable>& rhs) {
-        const auto lhs_var = Variable::create(lhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator*(const std::type_identity_t<T> lhs, const VariablePtr<T>& rhs) {
+        const auto lhs_var = BasicVariable<T>::create(lhs, false);
         return lhs_var->operator*(rhs);
     }
 
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs, const double rhs) {
-        const auto rhs_var = Variable::create(rhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator-(const VariablePtr<T>& lhs, const std::type_identity_t<T> rhs) {
+        const auto rhs_var = BasicVariable<T>::create(rhs, false);
         return lhs->operator-(rhs_var);
     }
 
-    std::shared_ptr<Variable> operator-(const double lhs, const std::shared_ptr<Variable>& rhs) {
-        const auto lhs_var = Variable::create(lhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator-(const std::type_identity_t<T> lhs, const VariablePtr<T>& rhs) {
+        const auto lhs_var = BasicVariable<T>::create(lhs, false);
         return lhs_var->operator-(rhs);
     }
 
-    std::shared_ptr<Variable> operator/(const std::shared_ptr<Variable>& lhs, const double rhs) {
-        const auto rhs_var = Variable::create(rhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator/(const VariablePtr<T>& lhs, const std::type_identity_t<T> rhs) {
+        const auto rhs_var = BasicVariable<T>::create(rhs, false);
         return lhs->operator/(rhs_var);
     }
 
-    std::shared_ptr<Variable> operator/(const double lhs, const std::shared_ptr<Variable>& rhs) {
-        const auto lhs_var = Variable::create(lhs, false);
+    template <Scalar T>
+    VariablePtr<T> operator/(const std::type_identity_t<T> lhs, const VariablePtr<T>& rhs) {
+        const auto lhs_var = BasicVariable<T>::create(lhs, false);
         return lhs_var->operator/(rhs);
     }
 
-    std::shared_ptr<Variable> pow(const std::shared_ptr<Variable>& lhs, const double rhs) {
-        const auto rhs_var = Variable::create(rhs, false);
+    template <Scalar T>
+    VariablePtr<T> pow(const VariablePtr<T>& lhs, const std::type_identity_t<T> rhs) {
+        const auto rhs_var = BasicVariable<T>::create(rhs, false);
         return pow(lhs, rhs_var);
     }
 
-    std::shared_ptr<Variable> pow(const double lhs, const std::shared_ptr<Variable>& rhs) {
-        const auto lhs_var = Variable::create(lhs, false);
+    template <Scalar T>
+    VariablePtr<T> pow(const std::type_identity_t<T> lhs, const VariablePtr<T>& rhs) {
+        const auto lhs_var = BasicVariable<T>::create(lhs, false);
         return pow(lhs_var, rhs);
     }
 
-}
\ No newline at end of file
+    template <Scalar T>
+    VariablePtr<T> sum(const std::vector<VariablePtr<T>>& terms) {
+        accumulate_t<T> total = 0.0;
+        bool requires_grad = false;
+        for (const auto& term : terms) {
+            total += term->value();
+            requires_grad = requires_grad || term->requires_grad();
+        }
+
+        if (!requires_grad) {
+            return BasicVariable<T>::create(static_cast<T>(total), false);
+        }
+        return BasicVariable<T>::create(static_cast<T>(total), true, std::make_shared<SumOperation<T>>(terms));
+    }
+
+    // Runs forward(x, y) over the input values, then derivative(x, y, dy) when any
+    // input needs a gradient, and wraps each y[i] in a node holding dy[i].
+    template <Scalar T, typename Forward, typename Derivative>
+    std::vector<VariablePtr<T>> map_elementwise(const std::vector<VariablePtr<T>>& inputs,
+                                                Forward forward, Derivative derivative) {
+        const size_t n = inputs.size();
+        std::vector<T> x(n), y(n), dy;
+        bool requires_grad = false;
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = inputs[i]->value();
+            requires_grad = requires_grad || inputs[i]->requires_grad();
+        }
+
+        forward(std::span<const T>(x), std::span<T>(y));
+        if (requires_grad) {
+            dy.resize(n);
+            derivative(std::span<const T>(x), std::span<const T>(y), std::span<T>(dy));
+        }
+
+        std::vector<VariablePtr<T>> outputs;
+        outputs.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (inputs[i]->requires_grad()) {
+                outputs.push_back(BasicVariable<T>::create(
+                    y[i], true, std::make_shared<ElementwiseOperation<T>>(inputs[i], dy[i])));
+            } else {
+                outputs.push_back(BasicVariable<T>::create(y[i], false));
+            }
+        }
+        return outputs;
+    }
+
+    template <Scalar T>
+    std::vector<VariablePtr<T>> exp(const std::vector<VariablePtr<T>>& inputs) {
+        return map_elementwise<T>(inputs, kernels::exp<T>,
+            [](std::span<const T>, const std::span<const T> y, const std::span<T> dy) {
+                std::ranges::copy(y, dy.begin());
+            });
+    }
+
+    template <Scalar T>
+    std::vector<VariablePtr<T>> log(const std::vector<VariablePtr<T>>& inputs) {
+        return map_elementwise<T>(inputs, kernels::log<T>,
+            [](const std::span<const T> x, std::span<const T>, const std::span<T> dy) {
+                for (size_t i = 0; i < x.size(); ++i) dy[i] = 1 / x[i];
+            });
+    }
+
+    template <Scalar T>
+    std::vector<VariablePtr<T>> tanh(const std::vector<VariablePtr<T>>& inputs) {
+        return map_elementwise<T>(inputs, kernels::tanh<T>,
+            [](std::span<const T>, const std::span<const T> y, const std::span<T> dy) {
+                for (size_t i = 0; i < y.size(); ++i) dy[i] = 1 - y[i] * y[i];
+            });
+    }
+
+    template <Scalar T>
+    std::vector<VariablePtr<T>> sin(const std::vector<VariablePtr<T>>& inputs) {
+        return map_elementwise<T>(inputs, kernels::sin<T>,
+            [](const std::span<const T> x, std::span<const T>, const std::span<T> dy) {
+                kernels::cos<T>(x, dy);
+            });
+    }
+
+    template <Scalar T>
+    std::vector<VariablePtr<T>> cos(const std::vector<VariablePtr<T>>& inputs) {
+        return map_elementwise<T>(inputs, kernels::cos<T>,
+            [](const std::span<const T> x, std::span<const T>, const std::span<T> dy) {
+                kernels::sin<T>(x, dy);
+                for (T& d : dy) d = -d;
+            });
+    }
+
+    // Shared by both fused losses: fused(values, residual) returns the summed loss.
+    template <Scalar T, typename Fused>
+    VariablePtr<T> fused_cross_entropy(const std::vector<VariablePtr<T>>& logits, const size_t n_samples,
+                                       Fused fused) {
+        std::vector<T> values(logits.size());
+        bool requires_grad = false;
+        for (size_t i = 0; i < logits.size(); ++i) {
+            values[i] = logits[i]->value();
+            requires_grad = requires_grad || logits[i]->requires_grad();
+        }
+
+        std::vector<T> residual(requires_grad ? logits.size() : 0);
+        const accumulate_t<T> scale = accumulate_t<T>(1) / n_samples;
+        const auto loss = static_cast<T>(fused(std::span<const T>(values), std::span<T>(residual)) * scale);
+
+        if (!requires_grad) {
+            return BasicVariable<T>::create(loss, false);
+        }
+        return BasicVariable<T>::create(loss, true,
+            std::make_shared<CrossEntropyOperation<T>>(logits, std::move(residual), scale));
+    }
+
+    template <Scalar T>
+    VariablePtr<T> sigmoid_cross_entropy(const std::vector<VariablePtr<T>>& logits, const std::vector<T>& targets) {
+        return fused_cross_entropy<T>(logits, targets.size(),
+            [&targets](const std::span<const T> values, const std::span<T> residual) {
+                return kernels::sigmoid_cross_entropy<T>(values, targets, residual);
+            });
+    }
+
+    template <Scalar T>
+    VariablePtr<T> softmax_cross_entropy(const std::vector<VariablePtr<T>>& logits, const std::vector<T>& labels,
+                                         const size_t n_classes) {
+        return fused_cross_entropy<T>(logits, labels.size(),
+            [&labels, n_classes](const std::span<const T> values, const std::span<T> residual) {
+                return kernels::softmax_cross_entropy<T>(values, labels, n_classes, residual);
+            });
+    }
+
+#define AUTODIFF_INSTANTIATE(T) \
+    template class BasicVariable<T>; \
+    template VariablePtr<T> operator+(const VariablePtr<T>&, const VariablePtr<T>&); \
+    template VariablePtr<T> operator-(const VariablePtr<T>&, const VariablePtr<T>&); \
+    template VariablePtr<T> operator-(const VariablePtr<T>&); \
+    template VariablePtr<T> operator*(const VariablePtr<T>&, const VariablePtr<T>&); \
+    template VariablePtr<T> operator/(const VariablePtr<T>&, const VariablePtr<T>&); \
+    template VariablePtr<T> pow(const VariablePtr<T>&, const VariablePtr<T>&); \
+    template VariablePtr<T> operator+(const VariablePtr<T>&, std::type_identity_t<T>); \
+    template VariablePtr<T> operator+(std::type_identity_t<T>, const VariablePtr<T>&); \
+    template VariablePtr<T> operator-(const VariablePtr<T>&, std::type_identity_t<T>); \
+    template VariablePtr<T> operator-(std::type_identity_t<T>, const VariablePtr<T>&); \
+    template VariablePtr<T> operator*(const VariablePtr<T>&, std::type_identity_t<T>); \
+    template VariablePtr<T> operator*(std::type_identity_t<T>, const VariablePtr<T>&); \
+    template VariablePtr<T> operator/(const VariablePtr<T>&, std::type_identity_t<T>); \
+    template VariablePtr<T> operator/(std::type_identity_t<T>, const VariablePtr<T>&); \
+    template VariablePtr<T> pow(const VariablePtr<T>&, std::type_identity_t<T>); \
+    template VariablePtr<T> pow(std::type_identity_t<T>, const VariablePtr<T>&); \
+    template VariablePtr<T> sum(const std::vector<VariablePtr<T>>&); \
+    template std::vector<VariablePtr<T>> exp(const std::vector<VariablePtr<T>>&); \
+    template std::vector<VariablePtr<T>> log(const std::vector<VariablePtr<T>>&); \
+    template std::vector<VariablePtr<T>> tanh(const std::vector<VariablePtr<T>>&); \
+    template std::vector<VariablePtr<T>> sin(const std::vector<VariablePtr<T>>&); \
+    template std::vector<VariablePtr<T>> cos(const std::vector<VariablePtr<T>>&); \
+    template VariablePtr<T> sigmoid_cross_entropy(const std::vector<VariablePtr<T>>&, const std::vector<T>&); \
+    template VariablePtr<T> softmax_cross_entropy(const std::vector<VariablePtr<T>>&, const std::vector<T>&, size_t);
+
+    AUTODIFF_INSTANTIATE(float)
+    AUTODIFF_INSTANTIATE(double)
+
+#undef AUTODIFF_INSTANTIATE
+
+}
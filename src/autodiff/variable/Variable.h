@@ -2,93 +2,127 @@
 #include <memory>
 #include <vector>
 #include <set>
+#include "autodiff/precision/Precision.h"
 
 namespace autodiff {
-    class Operation;
+    template <Scalar T> class Operation;
 
-    class Variable final : public std::enable_shared_from_this<Variable> {
+    template <Scalar T>
+    class BasicVariable final : public std::enable_shared_from_this<BasicVariable<T>> {
     public:
-        static std::shared_ptr<Variable> create(double value, bool requires_grad = false);
-        static std::shared_ptr<Variable> create(double value, bool requires_grad,
-                                               std::shared_ptr<Operation> grad_fn);
+        using value_type = T;
+        using Accum = accumulate_t<T>;
 
-        double value() const { return value_; }
-        double grad() const { return grad_; }
+        static std::shared_ptr<BasicVariable> create(T value, bool requires_grad = false);
+        static std::shared_ptr<BasicVariable> create(T value, bool requires_grad,
+                                                    std::shared_ptr<Operation<T>> grad_fn);
+
+        T value() const { return value_; }
+        Accum grad() const { return grad_; }
         bool requires_grad() const { return requires_grad_; }
 
-        void set_value(const double new_value) { value_ = new_value; }
-        void set_grad(const double grad) { grad_ = grad; }
+        void set_value(const T new_value) { value_ = new_value; }
+        void set_grad(const Accum grad) { grad_ = grad; }
         void zero_grad() { grad_ = 0.0; }
-        void add_grad(const double grad) { grad_ += grad; }
+        void add_grad(const Accum grad) { grad_ += grad; }
 
         void backward();
 
-        std::shared_ptr<Variable> operator+(const std::shared_ptr<Variable>& other);
-        std::shared_ptr<Variable> operator/(const std::shared_ptr<Variable>& other);
-        std::shared_ptr<Variable> operator*(const std::shared_ptr<Variable>& other);
-        std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& other);
-        std::shared_ptr<Variable> operator-();
+        std::shared_ptr<BasicVariable> operator+(const std::shared_ptr<BasicVariable>& other);
+        std::shared_ptr<BasicVariable> operator/(const std::shared_ptr<BasicVariable>& other);
+        std::shared_ptr<BasicVariable> operator*(const std::shared_ptr<BasicVariable>& other);
+        std::shared_ptr<BasicVariable> operator-(const std::shared_ptr<BasicVariable>& other);
+        std::shared_ptr<BasicVariable> operator-();
 
-        std::shared_ptr<Variable> exp();
-        std::shared_ptr<Variable> log();
-        std::shared_ptr<Variable> pow(const std::shared_ptr<Variable>& other);
-        std::shared_ptr<Variable> tanh();
-        std::shared_ptr<Variable> cos();
-        std::shared_ptr<Variable> sin();
+        std::shared_ptr<BasicVariable> exp();
+        std::shared_ptr<BasicVariable> log();
+        std::shared_ptr<BasicVariable> pow(const std::shared_ptr<BasicVariable>& other);
+        std::shared_ptr<BasicVariable> tanh();
+        std::shared_ptr<BasicVariable> cos();
+        std::shared_ptr<BasicVariable> sin();
 
         void print() const;
 
-        ~Variable() = default;
+        ~BasicVariable() = default;
 
     private:
-        double value_;
-        double grad_;
+        T value_;
+        Accum grad_;
         bool requires_grad_;
-        std::shared_ptr<Operation> grad_fn_;
-
-        explicit Variable(double value, bool requires_grad = false);
-        Variable(double value, bool requires_grad, std::shared_ptr<Operation> grad_fn);
-
-        Variable(const Variable& other) = delete;
-        Variable& operator=(const Variable& other) = delete;
-        Variable(Variable&& other) = delete;
-        Variable& operator=(Variable&& other) = delete;
-
-        void topological_sort(std::vector<std::shared_ptr<Variable>>& sorted, std::set<std::shared_ptr<Variable>>& visited);
-
-        friend class AddOperation;
-        friend class MultiplyOperation;
-        friend class DivideOperation;
-        friend class SubtractOperation;
-        friend class NegativeOperation;
-        friend class ExponentialOperation;
-        friend class LogarithmOperation;
-        friend class PowerOperation;
-        friend class TanhOperation;
-        friend class SineOperation;
-        friend class CosineOperation;
+        std::shared_ptr<Operation<T>> grad_fn_;
+
+        explicit BasicVariable(T value, bool requires_grad = false);
+        BasicVariable(T value, bool requires_grad, std::shared_ptr<Operation<T>> grad_fn);
+
+        BasicVariable(const BasicVariable& other) = delete;
+        BasicVariable& operator=(const BasicVariable& other) = delete;
+        BasicVariable(BasicVariable&& other) = delete;
+        BasicVariable& operator=(BasicVariable&& other) = delete;
+
+        void topological_sort(std::vector<std::shared_ptr<BasicVariable>>& sorted,
+                              std::set<std::shared_ptr<BasicVariable>>& visited);
+
+        template <Scalar> friend class AddOperation;
+        template <Scalar> friend class MultiplyOperation;
+        template <Scalar> friend class DivideOperation;
+        template <Scalar> friend class SubtractOperation;
+        template <Scalar> friend class NegativeOperation;
+        template <Scalar> friend class SumOperation;
+        template <Scalar> friend class ExponentialOperation;
+        template <Scalar> friend class LogarithmOperation;
+        template <Scalar> friend class PowerOperation;
+        template <Scalar> friend class TanhOperation;
+        template <Scalar> friend class SineOperation;
+        template <Scalar> friend class CosineOperation;
+        template <Scalar> friend class ElementwiseOperation;
+        template <Scalar> friend class CrossEntropyOperation;
     };
 
-    std::shared_ptr<Variable> operator+(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs);
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs);
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs);
-    std::shared_ptr<Variable> operator*(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs);
-    std::shared_ptr<Variable> operator/(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs);
-    std::shared_ptr<Variable> pow(const std::shared_ptr<Variable>& lhs, const std::shared_ptr<Variable>& rhs);
+    using Variable = BasicVariable<double>;
+
+    template <Scalar T>
+    using VariablePtr = std::shared_ptr<BasicVariable<T>>;
+
+    template <Scalar T> VariablePtr<T> operator+(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs);
+    template <Scalar T> VariablePtr<T> operator-(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs);
+    template <Scalar T> VariablePtr<T> operator-(const VariablePtr<T>& lhs);
+    template <Scalar T> VariablePtr<T> operator*(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs);
+    template <Scalar T> VariablePtr<T> operator/(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs);
+    template <Scalar T> VariablePtr<T> pow(const VariablePtr<T>& lhs, const VariablePtr<T>& rhs);
+
+    template <Scalar T> VariablePtr<T> operator+(const VariablePtr<T>& lhs, std::type_identity_t<T> rhs);
+    template <Scalar T> VariablePtr<T> operator+(std::type_identity_t<T> lhs, const VariablePtr<T>& rhs);
+
+    template <Scalar T> VariablePtr<T> operator-(const VariablePtr<T>& lhs, std::type_identity_t<T> rhs);
+    template <Scalar T> VariablePtr<T> operator-(std::type_identity_t<T> lhs, const VariablePtr<T>& rhs);
+
+    template <Scalar T> VariablePtr<T> operator*(const VariablePtr<T>& lhs, std::type_identity_t<T> rhs);
+    template <Scalar T> VariablePtr<T> operator*(std::type_identity_t<T> lhs, const VariablePtr<T>& rhs);
 
-    std::shared_ptr<Variable> operator+(const std::shared_ptr<Variable>& lhs, double rhs);
-    std::shared_ptr<Variable> operator+(double lhs, const std::shared_ptr<Variable>& rhs);
+    template <Scalar T> VariablePtr<T> operator/(const VariablePtr<T>& lhs, std::type_identity_t<T> rhs);
+    template <Scalar T> VariablePtr<T> operator/(std::type_identity_t<T> lhs, const VariablePtr<T>& rhs);
 
-    std::shared_ptr<Variable> operator-(const std::shared_ptr<Variable>& lhs, double rhs);
-    std::shared_ptr<Variable> operator-(double lhs, const std::shared_ptr<Variable>& rhs);
+    template <Scalar T> VariablePtr<T> pow(const VariablePtr<T>& lhs, std::type_identity_t<T> rhs);
+    template <Scalar T> VariablePtr<T> pow(std::type_identity_t<T> lhs, const VariablePtr<T>& rhs);
 
-    std::shared_ptr<Variable> operator*(const std::shared_ptr<Variable>& lhs, double rhs);
-    std::shared_ptr<Variable> operator*(double lhs, const std::shared_ptr<Variable>& rhs);
+    // Sum of all terms as a single node; the forward value is accumulated in accumulate_t<T>.
+    template <Scalar T> VariablePtr<T> sum(const std::vector<VariablePtr<T>>& terms);
 
-    std::shared_ptr<Variable> operator/(const std::shared_ptr<Variable>& lhs, double rhs);
-    std::shared_ptr<Variable> operator/(double lhs, const std::shared_ptr<Variable>& rhs);
+    // Elementwise functions over a batch, one output per input. Values come from
+    // the vectorized kernels in autodiff/kernels (see Transcendental.h for their
+    // error bounds); local derivatives are computed in the same pass.
+    template <Scalar T> std::vector<VariablePtr<T>> exp(const std::vector<VariablePtr<T>>& inputs);
+    template <Scalar T> std::vector<VariablePtr<T>> log(const std::vector<VariablePtr<T>>& inputs);
+    template <Scalar T> std::vector<VariablePtr<T>> tanh(const std::vector<VariablePtr<T>>& inputs);
+    template <Scalar T> std::vector<VariablePtr<T>> sin(const std::vector<VariablePtr<T>>& inputs);
+    template <Scalar T> std::vector<VariablePtr<T>> cos(const std::vector<VariablePtr<T>>& inputs);
 
-    std::shared_ptr<Variable> pow(const std::shared_ptr<Variable>& lhs, double rhs);
-    std::shared_ptr<Variable> pow(double lhs, const std::shared_ptr<Variable>& rhs);
+    // Mean binary cross-entropy of sigmoid(logits) against targets in [0, 1], as one node.
+    template <Scalar T> VariablePtr<T> sigmoid_cross_entropy(const std::vector<VariablePtr<T>>& logits,
+                                                             const std::vector<T>& targets);
+    // Mean softmax cross-entropy as one node. logits holds n rows of n_classes
+    // scores (row-major), labels the n class indices.
+    template <Scalar T> VariablePtr<T> softmax_cross_entropy(const std::vector<VariablePtr<T>>& logits,
+                                                             const std::vector<T>& labels, size_t n_classes);
 
-}
\ No newline at end of file
+}
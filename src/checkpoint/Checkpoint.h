@@ -0,0 +1,279 @@
+#pragma once
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "autodiff/precision/Precision.h"
+
+// Versioned binary checkpoints of a model and its optimizer.
+//
+// Layout: CheckpointHeader, then n_params values of the parameter type, then
+// n_state values of its accumulate type starting at the next 8-byte boundary.
+// Files are written to "<path>.tmp", synced and renamed over <path>, so a crash
+// never leaves a partial checkpoint behind. Restoring maps the file instead of
+// parsing it.
+
+namespace checkpoint {
+
+    struct CheckpointHeader {
+        char magic[4] = {'G', 'D', 'C', 'K'};
+        std::uint32_t version = 1;
+        std::uint32_t scalar_size = 0;
+        std::uint32_t flags = 0;
+        std::uint64_t epoch = 0;
+        std::uint64_t n_params = 0;
+        std::uint64_t n_state = 0;
+    };
+
+    constexpr std::uint32_t master_weights_flag = 1u << 0;
+
+    // Everything needed to resume training: parameter values (bias last), the
+    // optimizer's state and the number of completed epochs.
+    template <autodiff::Scalar T>
+    struct Snapshot {
+        std::vector<T> params;
+        std::vector<autodiff::accumulate_t<T>> state;
+        std::uint64_t epoch = 0;
+        bool master_weights = false;
+    };
+
+    inline size_t state_offset(const CheckpointHeader& header) {
+        const size_t end = sizeof(CheckpointHeader) + header.n_params * header.scalar_size;
+        return (end + 7) & ~size_t{7};
+    }
+
+    inline void write_all(const int fd, const void* data, size_t size, const std::string& path) {
+        const auto* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t written = ::write(fd, bytes, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "checkpoint: write " + path);
+            }
+            bytes += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+    template <autodiff::Scalar T>
+    void save(const std::string& path, const Snapshot<T>& snapshot) {
+        using Accum = autodiff::accumulate_t<T>;
+        CheckpointHeader header;
+        header.scalar_size = sizeof(T);
+        header.flags = snapshot.master_weights ? master_weights_flag : 0;
+        header.epoch = snapshot.epoch;
+        header.n_params = snapshot.params.size();
+        header.n_state = snapshot.state.size();
+
+        const std::string tmp = path + ".tmp";
+        const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "checkpoint: open " + tmp);
+        }
+
+        try {
+            const size_t params_end = sizeof(header) + snapshot.params.size() * sizeof(T);
+            const char padding[8] = {};
+            write_all(fd, &header, sizeof(header), tmp);
+            write_all(fd, snapshot.params.data(), snapshot.params.size() * sizeof(T), tmp);
+            write_all(fd, padding, state_offset(header) - params_end, tmp);
+            write_all(fd, snapshot.state.data(), snapshot.state.size() * sizeof(Accum), tmp);
+            if (::fsync(fd) != 0) {
+                throw std::system_error(errno, std::generic_category(), "checkpoint: fsync " + tmp);
+            }
+        } catch (...) {
+            ::close(fd);
+            ::unlink(tmp.c_str());
+            throw;
+        }
+        ::close(fd);
+
+        if (::rename(tmp.c_str(), path.c_str()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "checkpoint: rename " + tmp);
+        }
+
+        // Make the rename itself durable.
+        const size_t slash = path.find_last_of('/');
+        const std::string dir = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        const int dir_fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dir_fd >= 0) {
+            ::fsync(dir_fd);
+            ::close(dir_fd);
+        }
+    }
+
+    // Read-only memory mapping of a checkpoint file; values are read in place.
+    template <autodiff::Scalar T>
+    class MappedCheckpoint {
+    public:
+        using Accum = autodiff::accumulate_t<T>;
+
+        explicit MappedCheckpoint(const std::string& path) {
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "checkpoint: open " + path);
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "checkpoint: stat " + path);
+            }
+            size = static_cast<size_t>(info.st_size);
+            if (size < sizeof(CheckpointHeader)) {
+                ::close(fd);
+                throw std::runtime_error("checkpoint: truncated file " + path);
+            }
+            data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+            const int error = errno;
+            ::close(fd);
+            if (data == MAP_FAILED) {
+                data = nullptr;
+                throw std::system_error(error, std::generic_category(), "checkpoint: mmap " + path);
+            }
+
+            std::memcpy(&header_, data, sizeof(header_));
+            const CheckpointHeader expected;
+            if (std::memcmp(header_.magic, expected.magic, sizeof(expected.magic)) != 0 ||
+                header_.version != expected.version) {
+                unmap();
+                throw std::runtime_error("checkpoint: not a checkpoint file " + path);
+            }
+            if (header_.scalar_size != sizeof(T)) {
+                unmap();
+                throw std::runtime_error("checkpoint: scalar type mismatch in " + path);
+            }
+            // The counts come from the file: bound them by what fits before
+            // multiplying, so a corrupt header cannot wrap past these checks.
+            const size_t payload = size - sizeof(CheckpointHeader);
+            if (header_.n_params > payload / sizeof(T) || state_offset(header_) > size ||
+                header_.n_state > (size - state_offset(header_)) / sizeof(Accum)) {
+                unmap();
+                throw std::runtime_error("checkpoint: truncated file " + path);
+            }
+        }
+
+        ~MappedCheckpoint() { unmap(); }
+
+        MappedCheckpoint(const MappedCheckpoint&) = delete;
+        MappedCheckpoint& operator=(const MappedCheckpoint&) = delete;
+
+        const CheckpointHeader& header() const { return header_; }
+
+        std::span<const T> params() const {
+            return {reinterpret_cast<const T*>(static_cast<const char*>(data) + sizeof(CheckpointHeader)),
+                    header_.n_params};
+        }
+
+        std::span<const Accum> state() const {
+            return {reinterpret_cast<const Accum*>(static_cast<const char*>(data) + state_offset(header_)),
+                    header_.n_state};
+        }
+
+    private:
+        void* data = nullptr;
+        size_t size = 0;
+        CheckpointHeader header_;
+
+        void unmap() {
+            if (data) ::munmap(data, size);
+            data = nullptr;
+        }
+    };
+
+    // Writes checkpoints on a background thread. submit() only queues the
+    // snapshot, so the training loop never waits for the disk; if a write is
+    // still running, newer snapshots replace the queued one.
+    template <autodiff::Scalar T>
+    class AsyncCheckpointer {
+    public:
+        explicit AsyncCheckpointer(std::string path)
+            : path(std::move(path)), writer([this] { run(); }) {}
+
+        ~AsyncCheckpointer() {
+            {
+                std::lock_guard lock(mutex);
+                stopping = true;
+            }
+            pending_cv.notify_one();
+            writer.join();
+        }
+
+        AsyncCheckpointer(const AsyncCheckpointer&) = delete;
+        AsyncCheckpointer& operator=(const AsyncCheckpointer&) = delete;
+
+        void submit(Snapshot<T> snapshot) {
+            {
+                std::lock_guard lock(mutex);
+                rethrow_error();
+                pending = std::move(snapshot);
+            }
+            pending_cv.notify_one();
+        }
+
+        // Blocks until every submitted snapshot is on disk.
+        void flush() {
+            std::unique_lock lock(mutex);
+            idle_cv.wait(lock, [this] { return !pending && !writing; });
+            rethrow_error();
+        }
+
+        const std::string& file() const { return path; }
+
+    private:
+        std::string path;
+        std::mutex mutex;
+        std::condition_variable pending_cv;
+        std::condition_variable idle_cv;
+        std::optional<Snapshot<T>> pending;
+        bool writing = false;
+        bool stopping = false;
+        std::exception_ptr error;
+        std::thread writer;
+
+        void rethrow_error() {
+            if (error) {
+                std::exception_ptr e = error;
+                error = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+
+        void run() {
+            std::unique_lock lock(mutex);
+            while (true) {
+                pending_cv.wait(lock, [this] { return pending || stopping; });
+                if (!pending) return;
+
+                Snapshot<T> snapshot = std::move(*pending);
+                pending.reset();
+                writing = true;
+                lock.unlock();
+                try {
+                    save(path, snapshot);
+                } catch (...) {
+                    lock.lock();
+                    error = std::current_exception();
+                    lock.unlock();
+                }
+                lock.lock();
+                writing = false;
+                idle_cv.notify_all();
+            }
+        }
+    };
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "autodiff/variable/Variable.h"
+#include "checkpoint/Checkpoint.h"
+
+// Moves trainable parameters between Variables and checkpoints. The optimizer
+// supplies (and takes back) its own state and epoch counter.
+
+namespace checkpoint {
+
+    template <autodiff::Scalar T>
+    Snapshot<T> capture(const std::vector<autodiff::VariablePtr<T>>& w,
+                        std::vector<autodiff::accumulate_t<T>> state,
+                        const std::uint64_t epoch,
+                        const bool master_weights) {
+        Snapshot<T> result;
+        result.params.reserve(w.size());
+        for (const auto& param : w) {
+            result.params.push_back(param->value());
+        }
+        result.state = std::move(state);
+        result.epoch = epoch;
+        result.master_weights = master_weights;
+        return result;
+    }
+
+    // Loads the parameter values of the checkpoint at `path` into w, clearing
+    // their gradients; w is rebuilt with new Variables if its size differs.
+    // Returns the rest of the snapshot (state, epoch and flags; params empty).
+    template <autodiff::Scalar T>
+    Snapshot<T> restore(const std::string& path, std::vector<autodiff::VariablePtr<T>>& w) {
+        const MappedCheckpoint<T> mapped(path);
+        const auto params = mapped.params();
+        const auto state = mapped.state();
+
+        if (w.size() != params.size()) {
+            w.clear();
+            w.reserve(params.size());
+            for (const T value : params) {
+                w.push_back(autodiff::BasicVariable<T>::create(value, true));
+            }
+        } else {
+            for (size_t i = 0; i < params.size(); ++i) {
+                w[i]->set_value(params[i]);
+                w[i]->zero_grad();
+            }
+        }
+
+        Snapshot<T> result;
+        result.state.assign(state.begin(), state.end());
+        result.epoch = mapped.header().epoch;
+        result.master_weights = (mapped.header().flags & master_weights_flag) != 0;
+        return result;
+    }
+
+}
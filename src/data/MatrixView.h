@@ -0,0 +1,18 @@
+#pragma once
+#include <span>
+#include "autodiff/precision/Precision.h"
+
+// Non-owning row-major view: row i starts at data + i * stride and holds `cols`
+// values. Used for NumPy buffers and for strided views that share storage
+// between rows.
+template <autodiff::Scalar T = double>
+struct MatrixView {
+    const T* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t stride = 0;
+
+    std::span<const T> row(const size_t i) const {
+        return {data + i * stride, cols};
+    }
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "autodiff/precision/Precision.h"
+
+// Compressed sparse row matrix: row i holds the entries indices[indptr[i]..indptr[i+1])
+// and values[indptr[i]..indptr[i+1]]. Same layout as scipy.sparse.csr_matrix.
+template <autodiff::Scalar T = double>
+class CsrMatrix {
+public:
+    struct Row {
+        std::span<const size_t> indices;
+        std::span<const T> values;
+
+        size_t nnz() const { return indices.size(); }
+    };
+
+    CsrMatrix() : indptr_(1, 0) {}
+
+    CsrMatrix(const size_t rows, const size_t cols,
+              std::vector<size_t> indptr, std::vector<size_t> indices, std::vector<T> values)
+        : rows_(rows), cols_(cols),
+          indptr_(std::move(indptr)), indices_(std::move(indices)), values_(std::move(values)) {
+        if (indptr_.size() != rows_ + 1 || indptr_.front() != 0) {
+            throw std::invalid_argument("CsrMatrix: indptr must have rows + 1 entries starting at 0");
+        }
+        if (indptr_.back() != indices_.size() || indices_.size() != values_.size()) {
+            throw std::invalid_argument("CsrMatrix: indptr, indices and values sizes disagree");
+        }
+        for (size_t i = 0; i < rows_; ++i) {
+            if (indptr_[i] > indptr_[i + 1]) {
+                throw std::invalid_argument("CsrMatrix: indptr must be non-decreasing");
+            }
+        }
+        for (const size_t column : indices_) {
+            if (column >= cols_) {
+                throw std::invalid_argument("CsrMatrix: column index out of range");
+            }
+        }
+    }
+
+    static CsrMatrix from_dense(const std::vector<std::vector<T>>& dense) {
+        const size_t rows = dense.size();
+        const size_t cols = rows == 0 ? 0 : dense.front().size();
+        std::vector<size_t> indptr{0};
+        std::vector<size_t> indices;
+        std::vector<T> values;
+        indptr.reserve(rows + 1);
+
+        for (const auto& row : dense) {
+            for (size_t j = 0; j < row.size(); ++j) {
+                if (row[j] != T(0)) {
+                    indices.push_back(j);
+                    values.push_back(row[j]);
+                }
+            }
+            indptr.push_back(indices.size());
+        }
+
+        return CsrMatrix(rows, cols, std::move(indptr), std::move(indices), std::move(values));
+    }
+
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t nnz() const { return values_.size(); }
+
+    Row row(const size_t i) const {
+        const size_t begin = indptr_[i];
+        const size_t count = indptr_[i + 1] - begin;
+        return {std::span<const size_t>(indices_).subspan(begin, count),
+                std::span<const T>(values_).subspan(begin, count)};
+    }
+
+    const std::vector<size_t>& indptr() const { return indptr_; }
+    const std::vector<size_t>& indices() const { return indices_; }
+    const std::vector<T>& values() const { return values_; }
+
+private:
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    std::vector<size_t> indptr_;
+    std::vector<size_t> indices_;
+    std::vector<T> values_;
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "data/stream/DataSource.h"
+
+// Raw row-major binary dataset: a fixed header followed by one record per row
+// holding n_features values and then the target, all of the writer's scalar type.
+struct BinaryDatasetHeader {
+    char magic[4] = {'G', 'D', 'D', 'S'};
+    std::uint32_t version = 1;
+    std::uint32_t scalar_size = 0;
+    std::uint32_t reserved = 0;
+    std::uint64_t n_features = 0;
+    std::uint64_t n_rows = 0;
+};
+
+template <autodiff::Scalar T = double>
+class BinarySource final : public DataSource<T> {
+public:
+    explicit BinarySource(std::string path, const size_t chunk_rows = 65536)
+        : path(std::move(path)), chunk_rows(chunk_rows == 0 ? 1 : chunk_rows),
+          file(std::fopen(this->path.c_str(), "rb"), &std::fclose) {
+        if (!file) {
+            throw std::runtime_error("BinarySource: cannot open " + this->path);
+        }
+        if (std::fread(&header, sizeof(header), 1, file.get()) != 1 ||
+            std::memcmp(header.magic, BinaryDatasetHeader{}.magic, sizeof(header.magic)) != 0 ||
+            header.version != BinaryDatasetHeader{}.version) {
+            throw std::runtime_error("BinarySource: not a dataset file: " + this->path);
+        }
+        if (header.scalar_size != sizeof(T)) {
+            throw std::runtime_error("BinarySource: scalar type mismatch in " + this->path);
+        }
+        // The header's row count must match the file, so truncation is an error
+        // rather than a shorter dataset.
+        const size_t record_size = sizeof(T) * (header.n_features + 1);
+        if (std::fseek(file.get(), 0, SEEK_END) != 0) {
+            throw std::runtime_error("BinarySource: cannot seek in " + this->path);
+        }
+        const long size = std::ftell(file.get());
+        const std::uint64_t payload = size < 0 ? 0 : static_cast<std::uint64_t>(size) - sizeof(header);
+        if (size < 0 || payload % record_size != 0 || payload / record_size != header.n_rows) {
+            throw std::runtime_error("BinarySource: file size does not match its header in " + this->path);
+        }
+        reset();
+        std::setvbuf(file.get(), nullptr, _IOFBF, 1 << 20);
+        record.resize(chunk_rows * (header.n_features + 1));
+    }
+
+    // Writes X and y in the format read by BinarySource<T>.
+    static void write(const std::string& path, const std::vector<std::vector<T>>& X, const std::vector<T>& y) {
+        BinaryDatasetHeader header;
+        header.scalar_size = sizeof(T);
+        header.n_features = X.empty() ? 0 : X.front().size();
+        header.n_rows = y.size();
+        if (X.size() != y.size()) {
+            throw std::invalid_argument("BinarySource: X and y differ in row count");
+        }
+        for (const auto& row : X) {
+            if (row.size() != header.n_features) {
+                throw std::invalid_argument("BinarySource: rows of X differ in length");
+            }
+        }
+
+        const std::unique_ptr<std::FILE, int (*)(std::FILE*)> out(std::fopen(path.c_str(), "wb"), &std::fclose);
+        if (!out) {
+            throw std::runtime_error("BinarySource: cannot create " + path);
+        }
+        bool ok = std::fwrite(&header, sizeof(header), 1, out.get()) == 1;
+        for (size_t i = 0; ok && i < y.size(); ++i) {
+            ok = std::fwrite(X[i].data(), sizeof(T), header.n_features, out.get()) == header.n_features &&
+                 std::fwrite(&y[i], sizeof(T), 1, out.get()) == 1;
+        }
+        if (!ok) {
+            throw std::runtime_error("BinarySource: write failed for " + path);
+        }
+    }
+
+    bool next(Chunk<T>& chunk) override {
+        const size_t width = header.n_features + 1;
+        const size_t wanted = static_cast<size_t>(std::min<std::uint64_t>(chunk_rows, header.n_rows - rows_read));
+        const size_t read = wanted == 0 ? 0 : std::fread(record.data(), sizeof(T) * width, wanted, file.get());
+        if (read < wanted) {
+            throw std::runtime_error(std::string("BinarySource: ") +
+                                     (std::ferror(file.get()) ? "read failed for " : "truncated file ") + path);
+        }
+        rows_read += read;
+
+        chunk.X.resize(read);
+        chunk.y.resize(read);
+        for (size_t i = 0; i < read; ++i) {
+            const T* row = record.data() + i * width;
+            chunk.X[i].assign(row, row + header.n_features);
+            chunk.y[i] = row[header.n_features];
+        }
+        return read > 0;
+    }
+
+    void reset() override {
+        std::clearerr(file.get());
+        if (std::fseek(file.get(), sizeof(BinaryDatasetHeader), SEEK_SET) != 0) {
+            throw std::runtime_error("BinarySource: cannot seek in " + path);
+        }
+        rows_read = 0;
+    }
+
+    size_t n_features() const override {
+        return header.n_features;
+    }
+
+    size_t n_rows() const {
+        return header.n_rows;
+    }
+
+private:
+    std::string path;
+    size_t chunk_rows;
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file;
+    BinaryDatasetHeader header;
+    std::uint64_t rows_read = 0;
+    std::vector<T> record;
+};
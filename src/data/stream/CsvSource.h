@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "data/stream/DataSource.h"
+
+// Reads numeric CSV rows in chunks of `chunk_rows`. One column is the target
+// (the last one by default); every other column is a feature.
+template <autodiff::Scalar T = double>
+class CsvSource final : public DataSource<T> {
+public:
+    static constexpr size_t last_column = static_cast<size_t>(-1);
+
+    explicit CsvSource(std::string path, const size_t chunk_rows = 65536,
+                       const size_t target_column = last_column, const bool has_header = true)
+        : path(std::move(path)), chunk_rows(chunk_rows == 0 ? 1 : chunk_rows),
+          target_column(target_column), has_header(has_header), buffer(1 << 20) {
+        open();
+        // Peek at the first data row to learn the width, then rewind.
+        std::string line;
+        if (read_line(line)) {
+            n_columns = 1;
+            for (const char c : line) {
+                if (c == ',') ++n_columns;
+            }
+        }
+        if (n_columns > 0 && target_column != last_column && target_column >= n_columns) {
+            throw std::invalid_argument("CsvSource: target column " + std::to_string(target_column) +
+                                        " is out of range for " + std::to_string(n_columns) + " columns in " +
+                                        this->path);
+        }
+        open();
+    }
+
+    bool next(Chunk<T>& chunk) override {
+        const size_t features = n_features();
+        const size_t target = target_column == last_column ? n_columns - 1 : target_column;
+        size_t rows = 0;
+        std::string line;
+
+        chunk.X.resize(chunk_rows);
+        chunk.y.resize(chunk_rows);
+        while (rows < chunk_rows && read_line(line)) {
+            auto& x = chunk.X[rows];
+            x.resize(features);
+
+            const char* cursor = line.data();
+            const char* const end = line.data() + line.size();
+            size_t feature = 0;
+            for (size_t column = 0; column < n_columns; ++column) {
+                const char* const field_end = std::find(cursor, end, ',');
+                T value{};
+                const auto [ptr, ec] = std::from_chars(skip_space(cursor, field_end), field_end, value);
+                if (ec != std::errc() || skip_space(ptr, field_end) != field_end) {
+                    throw std::runtime_error("CsvSource: invalid number at " + path + ":" + std::to_string(line_number));
+                }
+                if (column == target) {
+                    chunk.y[rows] = value;
+                } else if (feature < features) {
+                    x[feature++] = value;
+                }
+                cursor = field_end == end ? end : field_end + 1;
+            }
+            if (cursor != end || (!line.empty() && line.back() == ',')) {
+                throw std::runtime_error("CsvSource: expected " + std::to_string(n_columns) + " columns at " + path +
+                                         ":" + std::to_string(line_number));
+            }
+            ++rows;
+        }
+
+        chunk.X.resize(rows);
+        chunk.y.resize(rows);
+        return rows > 0;
+    }
+
+    void reset() override {
+        open();
+    }
+
+    size_t n_features() const override {
+        return n_columns == 0 ? 0 : n_columns - 1;
+    }
+
+private:
+    std::string path;
+    size_t chunk_rows;
+    size_t target_column;
+    bool has_header;
+    std::vector<char> buffer;
+    std::ifstream file;
+    size_t n_columns = 0;
+    size_t line_number = 0;
+
+    void open() {
+        file = std::ifstream();
+        file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        file.open(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("CsvSource: cannot open " + path);
+        }
+        line_number = 0;
+        if (has_header) {
+            std::string header;
+            std::getline(file, header);
+            ++line_number;
+        }
+    }
+
+    bool read_line(std::string& line) {
+        while (std::getline(file, line)) {
+            ++line_number;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty()) return true;
+        }
+        return false;
+    }
+
+    static const char* skip_space(const char* begin, const char* end) {
+        while (begin != end && (*begin == ' ' || *begin == '\t')) ++begin;
+        return begin;
+    }
+};
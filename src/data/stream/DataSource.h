@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include "autodiff/precision/Precision.h"
+
+// A block of consecutive rows read from a data source.
+template <autodiff::Scalar T = double>
+struct Chunk {
+    std::vector<std::vector<T>> X;
+    std::vector<T> y;
+
+    size_t rows() const { return y.size(); }
+};
+
+// Sequential reader over a dataset too large to hold in memory. Sources fill the
+// caller's chunk in place so row buffers are reused from one chunk to the next.
+template <autodiff::Scalar T = double>
+class DataSource {
+public:
+    virtual ~DataSource() = default;
+
+    // Fills `chunk` with the next rows; returns false once the data is exhausted.
+    virtual bool next(Chunk<T>& chunk) = 0;
+
+    // Rewinds to the first row, e.g. at the start of an epoch.
+    virtual void reset() = 0;
+
+    virtual size_t n_features() const = 0;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "data/stream/DataSource.h"
+
+// Double-buffered wrapper: a background thread reads the next chunk from the
+// wrapped source while the caller trains on the current one. At most two chunks
+// are resident (the caller's and the one being prefetched), and their row
+// buffers are recycled between the two threads.
+template <autodiff::Scalar T = double>
+class PrefetchSource final : public DataSource<T> {
+public:
+    // Reading starts at the first reset() or next(), so the reset() that opens
+    // each training pass does not throw away a chunk read ahead of it.
+    explicit PrefetchSource(std::shared_ptr<DataSource<T>> source) : source(std::move(source)) {}
+
+    ~PrefetchSource() override {
+        stop();
+    }
+
+    PrefetchSource(const PrefetchSource&) = delete;
+    PrefetchSource& operator=(const PrefetchSource&) = delete;
+
+    bool next(Chunk<T>& chunk) override {
+        if (!reader.joinable()) start();
+        std::unique_lock lock(mutex);
+        ready_cv.wait(lock, [this] { return ready || error || exhausted; });
+        if (error) std::rethrow_exception(error);
+        if (!ready) return false;
+
+        // Hand the caller's previous buffer back to the reader.
+        std::swap(chunk, buffer);
+        ready = false;
+        lock.unlock();
+        free_cv.notify_one();
+        return true;
+    }
+
+    void reset() override {
+        stop();
+        source->reset();
+        start();
+    }
+
+    size_t n_features() const override {
+        return source->n_features();
+    }
+
+private:
+    std::shared_ptr<DataSource<T>> source;
+    Chunk<T> buffer;
+    std::thread reader;
+    std::mutex mutex;
+    std::condition_variable ready_cv;
+    std::condition_variable free_cv;
+    bool ready = false;
+    bool exhausted = false;
+    bool stopping = false;
+    std::exception_ptr error;
+
+    void start() {
+        ready = false;
+        exhausted = false;
+        stopping = false;
+        error = nullptr;
+        reader = std::thread([this] { read_ahead(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        free_cv.notify_all();
+        if (reader.joinable()) reader.join();
+    }
+
+    void read_ahead() {
+        try {
+            while (true) {
+                {
+                    std::unique_lock lock(mutex);
+                    free_cv.wait(lock, [this] { return !ready || stopping; });
+                    if (stopping) return;
+                }
+                // The caller only touches `buffer` once `ready` is set, so it is
+                // filled without holding the lock.
+                const bool has_rows = source->next(buffer);
+                {
+                    std::lock_guard lock(mutex);
+                    if (has_rows) {
+                        ready = true;
+                    } else {
+                        exhausted = true;
+                    }
+                }
+                ready_cv.notify_one();
+                if (!has_rows) return;
+            }
+        } catch (...) {
+            {
+                std::lock_guard lock(mutex);
+                error = std::current_exception();
+            }
+            ready_cv.notify_one();
+        }
+    }
+};
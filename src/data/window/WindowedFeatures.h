@@ -0,0 +1,184 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "data/MatrixView.h"
+
+// Lag-window features over a univariate series: row i holds `window`
+// consecutive values and its target is the value right after them. Row i + 1
+// starts one element after row i, so the rows are a MatrixView with stride 1
+// over the (normalized) series and nothing is stored per row. Memory is
+// O(series length) for any window size.
+//
+// Normalization is applied once to the series, so features and targets share
+// it and predictions are mapped back with denormalize():
+//   raw          - no normalization; views the caller's series, which must
+//                  outlive this object.
+//   standardized - one mean and standard deviation taken over the points seen
+//                  by the first `train_rows` rows (their features and targets).
+//   rolling      - each point is standardized by the mean and standard
+//                  deviation of the `lookback` points before it, so no row
+//                  uses information from after its target. The first
+//                  `lookback` points have no statistics and are skipped.
+template <autodiff::Scalar T = double>
+class WindowedFeatures {
+public:
+    using Accum = autodiff::accumulate_t<T>;
+
+    static constexpr size_t all = std::numeric_limits<size_t>::max();
+
+    static WindowedFeatures raw(const std::span<const T> series, const size_t window) {
+        WindowedFeatures result(series.size(), window, 0);
+        result.external_ = series.data();
+        return result;
+    }
+
+    static WindowedFeatures standardized(const std::span<const T> series, const size_t window,
+                                         const size_t train_rows = all) {
+        WindowedFeatures result(series.size(), window, 0);
+        const size_t fit_points = std::min(series.size(), std::min(train_rows, result.rows_) + window);
+        if (fit_points <= window) {
+            throw std::invalid_argument("WindowedFeatures: need at least one training row");
+        }
+
+        Accum mean = 0;
+        for (size_t t = 0; t < fit_points; ++t) {
+            mean += series[t];
+        }
+        mean /= static_cast<Accum>(fit_points);
+        Accum m2 = 0;
+        for (size_t t = 0; t < fit_points; ++t) {
+            const Accum d = series[t] - mean;
+            m2 += d * d;
+        }
+        result.mean_.assign(1, mean);
+        result.scale_.assign(1, scale_of(m2 / static_cast<Accum>(fit_points)));
+
+        result.storage_.resize(series.size());
+        const Accum inverse = 1 / result.scale_[0];
+        for (size_t t = 0; t < series.size(); ++t) {
+            result.storage_[t] = static_cast<T>((series[t] - mean) * inverse);
+        }
+        return result;
+    }
+
+    static WindowedFeatures rolling(const std::span<const T> series, const size_t window, const size_t lookback) {
+        if (lookback < 2) {
+            throw std::invalid_argument("WindowedFeatures: rolling lookback must be at least 2");
+        }
+        WindowedFeatures result(series.size(), window, lookback);
+        const size_t n = series.size();
+        result.storage_.assign(n, T(0));
+        result.mean_.assign(n, 0);
+        result.scale_.assign(n, 1);
+
+        // Statistics of the window [t - lookback, t), slid by one point per step.
+        // They are recomputed exactly every `lookback` steps, and whenever the
+        // update cancels most of the variance, so rounding cannot build up.
+        const Accum count = static_cast<Accum>(lookback);
+        Accum mean = 0;
+        Accum m2 = 0;
+        const auto recompute = [&](const size_t t) {
+            mean = 0;
+            for (size_t s = t - lookback; s < t; ++s) {
+                mean += series[s];
+            }
+            mean /= count;
+            m2 = 0;
+            for (size_t s = t - lookback; s < t; ++s) {
+                const Accum d = series[s] - mean;
+                m2 += d * d;
+            }
+        };
+        for (size_t t = lookback; t < n; ++t) {
+            if ((t - lookback) % lookback == 0) {
+                recompute(t);
+            } else {
+                const Accum added = series[t - 1];
+                const Accum removed = series[t - lookback - 1];
+                const Accum next_mean = mean + (added - removed) / count;
+                const Accum change = (added - removed) * (added - next_mean + removed - mean);
+                if (m2 + change <= (m2 + std::fabs(change)) / 16) {
+                    recompute(t);
+                } else {
+                    m2 += change;
+                    mean = next_mean;
+                }
+            }
+            const Accum scale = scale_of(m2 / count);
+            result.mean_[t] = mean;
+            result.scale_[t] = scale;
+            result.storage_[t] = static_cast<T>((series[t] - mean) / scale);
+        }
+        return result;
+    }
+
+    size_t rows() const { return rows_; }
+    size_t window() const { return window_; }
+
+    // Index in the series of row 0's first feature; row i's target is at
+    // offset() + i + window().
+    size_t offset() const { return offset_; }
+
+    // Rows [begin, end) as a zero-copy view with `window` columns.
+    MatrixView<T> features(const size_t begin = 0, size_t end = all) const {
+        end = clamp_range(begin, end);
+        return {values() + offset_ + begin, end - begin, window_, 1};
+    }
+
+    std::span<const T> targets(const size_t begin = 0, size_t end = all) const {
+        end = clamp_range(begin, end);
+        return {values() + offset_ + window_ + begin, end - begin};
+    }
+
+    // Maps normalized predictions for rows first_row, first_row + 1, ... back to
+    // the scale of the series, in place.
+    void denormalize(const std::span<T> y, const size_t first_row = 0) const {
+        if (first_row + y.size() > rows_) {
+            throw std::out_of_range("WindowedFeatures: row range out of bounds");
+        }
+        if (mean_.empty()) return;
+        for (size_t k = 0; k < y.size(); ++k) {
+            const size_t t = mean_.size() == 1 ? 0 : offset_ + window_ + first_row + k;
+            y[k] = static_cast<T>(y[k] * scale_[t] + mean_[t]);
+        }
+    }
+
+private:
+    size_t window_;
+    size_t offset_;
+    size_t rows_;
+    const T* external_ = nullptr; // The caller's series, for raw
+    std::vector<T> storage_;      // The normalized series otherwise
+    // One entry for standardized, one per series point for rolling.
+    std::vector<Accum> mean_;
+    std::vector<Accum> scale_;
+
+    WindowedFeatures(const size_t length, const size_t window, const size_t offset)
+        : window_(window), offset_(offset), rows_(length > offset + window ? length - offset - window : 0) {
+        if (window == 0) {
+            throw std::invalid_argument("WindowedFeatures: window must be positive");
+        }
+    }
+
+    const T* values() const {
+        return storage_.empty() ? external_ : storage_.data();
+    }
+
+    // Constant stretches get a unit scale instead of a division by zero.
+    static Accum scale_of(const Accum variance) {
+        const Accum scale = std::sqrt(variance);
+        return scale > 0 ? scale : Accum(1);
+    }
+
+    size_t clamp_range(const size_t begin, size_t end) const {
+        end = std::min(end, rows_);
+        if (begin > end) {
+            throw std::out_of_range("WindowedFeatures: row range out of bounds");
+        }
+        return end;
+    }
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <span>
+
+// Collective operations between the worker processes of a data-parallel job.
+// Every rank must make the same sequence of calls with the same sizes.
+
+namespace distributed {
+
+    class Communicator {
+    public:
+        virtual ~Communicator() = default;
+
+        virtual size_t rank() const = 0;
+        virtual size_t size() const = 0;
+
+        // Replaces data on every rank with the elementwise sum over all ranks.
+        // All ranks receive bit-identical results.
+        virtual void allreduce(std::span<double> data) = 0;
+
+        virtual void barrier() = 0;
+    };
+
+    // Rows [begin, end) of n owned by `rank` when n rows are split evenly.
+    struct Shard {
+        size_t begin;
+        size_t end;
+    };
+
+    inline Shard shard(const size_t n, const size_t rank, const size_t size) {
+        const size_t base = n / size;
+        const size_t extra = n % size;
+        const size_t begin = rank * base + (rank < extra ? rank : extra);
+        return {begin, begin + base + (rank < extra ? 1 : 0)};
+    }
+
+}
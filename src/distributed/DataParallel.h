@@ -0,0 +1,115 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "distributed/Communicator.h"
+#include "optimizers/GradientDescent.h"
+
+namespace distributed {
+
+    // Synchronous data-parallel training: every rank holds the same parameters
+    // and a shard of the rows, computes gradients on its shard, and the
+    // row-weighted gradients are summed with one allreduce before each rank
+    // applies the same optimizer step. With equal starting weights (see
+    // sync_parameters) all ranks stay bit-identical, and a step matches a
+    // full-batch step on the concatenated shards up to summation order.
+    //
+    // Losses are assumed to be means over rows, like MSE and the cross-entropies.
+    template <autodiff::Scalar T = double>
+    class DataParallel {
+    public:
+        using Vector = std::vector<T>;
+        using Matrix = std::vector<Vector>;
+        using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+
+        DataParallel(GradientDescent<T>& optimizer, Communicator& comm)
+            : optimizer_(optimizer), comm_(comm) {}
+
+        Communicator& communicator() const { return comm_; }
+
+        // Copies rank 0's parameter values to every rank.
+        void sync_parameters(std::vector<Variable>& w) {
+            buffer_.resize(w.size());
+            for (size_t i = 0; i < w.size(); ++i) {
+                buffer_[i] = comm_.rank() == 0 ? static_cast<double>(w[i]->value()) : 0.0;
+            }
+            comm_.allreduce(buffer_);
+            for (size_t i = 0; i < w.size(); ++i) {
+                w[i]->set_value(static_cast<T>(buffer_[i]));
+            }
+        }
+
+        void sync_parameters(Model<T>& model) {
+            auto params = model.parameters();
+            sync_parameters(params);
+        }
+
+        // One step on this rank's shard; returns the loss over all ranks' rows
+        // before the update. Ranks may hold different (or zero) row counts.
+        T train(std::vector<Variable>& w,
+                const Matrix& X,
+                const Vector& y_true,
+                LossFunction<T>& loss_fn,
+                const T& learning_rate) {
+            const T loss = y_true.empty() ? T(0) : optimizer_.compute_gradients(w, X, y_true, loss_fn);
+            return reduce_and_step(w, loss, y_true.size(), learning_rate);
+        }
+
+        // The model's outputs are compared with y_true as in GradientDescent::train.
+        T train(Model<T>& model,
+                const MatrixView<T>& X,
+                const Vector& y_true,
+                LossFunction<T>& loss_fn,
+                const T& learning_rate) {
+            const T loss = X.rows == 0 ? T(0) : optimizer_.compute_gradients(model, X, y_true, loss_fn);
+            auto params = model.parameters();
+            return reduce_and_step(params, loss, X.rows, learning_rate);
+        }
+
+        // Runs `epochs` steps and returns the global loss of each.
+        std::vector<T> fit(std::vector<Variable>& w,
+                           const Matrix& X,
+                           const Vector& y_true,
+                           LossFunction<T>& loss_fn,
+                           const T& learning_rate,
+                           const size_t epochs) {
+            std::vector<T> losses;
+            losses.reserve(epochs);
+            for (size_t e = 0; e < epochs; ++e) {
+                losses.push_back(train(w, X, y_true, loss_fn, learning_rate));
+            }
+            return losses;
+        }
+
+    private:
+        GradientDescent<T>& optimizer_;
+        Communicator& comm_;
+        std::vector<double> buffer_;
+
+        // Sends [n_r g_r..., n_r loss_r, n_r] through one allreduce, so the mean
+        // gradient, mean loss and total row count arrive together.
+        T reduce_and_step(std::vector<Variable>& w, const T local_loss, const size_t rows,
+                          const T& learning_rate) {
+            const size_t n = w.size();
+            const double weight = static_cast<double>(rows);
+            buffer_.resize(n + 2);
+            for (size_t i = 0; i < n; ++i) {
+                buffer_[i] = rows == 0 ? 0.0 : weight * static_cast<double>(w[i]->grad());
+            }
+            buffer_[n] = rows == 0 ? 0.0 : weight * static_cast<double>(local_loss);
+            buffer_[n + 1] = weight;
+            comm_.allreduce(buffer_);
+
+            const double total_rows = buffer_[n + 1];
+            if (total_rows == 0) {
+                throw std::invalid_argument("DataParallel: no rows on any rank");
+            }
+            for (size_t i = 0; i < n; ++i) {
+                w[i]->set_grad(static_cast<autodiff::accumulate_t<T>>(buffer_[i] / total_rows));
+            }
+            optimizer_.step(w, learning_rate);
+            return static_cast<T>(buffer_[n] / total_rows);
+        }
+    };
+
+}
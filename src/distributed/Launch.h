@@ -0,0 +1,95 @@
+#pragma once
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace distributed {
+
+    // Runs worker(rank, n_workers) in n_workers forked processes and waits for
+    // them. A worker that throws prints the error and exits non-zero; the
+    // remaining workers are then terminated (they would block in the next
+    // collective) and launch() throws. Fork before starting any threads.
+    inline void launch(const size_t n_workers, const std::function<void(size_t rank, size_t size)>& worker) {
+        if (n_workers == 0) {
+            throw std::invalid_argument("launch: need at least one worker");
+        }
+        std::fflush(nullptr);
+
+        std::vector<pid_t> children;
+        children.reserve(n_workers);
+        const auto terminate_all = [&children] {
+            for (const pid_t child : children) {
+                if (child > 0) ::kill(child, SIGTERM);
+            }
+            for (const pid_t child : children) {
+                if (child > 0) ::waitpid(child, nullptr, 0);
+            }
+        };
+
+        for (size_t rank = 0; rank < n_workers; ++rank) {
+            const pid_t pid = ::fork();
+            if (pid < 0) {
+                const int error = errno;
+                terminate_all();
+                throw std::system_error(error, std::generic_category(), "launch: fork");
+            }
+            if (pid == 0) {
+                int status = 0;
+                try {
+                    worker(rank, n_workers);
+                } catch (const std::exception& e) {
+                    std::fprintf(stderr, "worker %zu: %s\n", rank, e.what());
+                    status = 1;
+                } catch (...) {
+                    std::fprintf(stderr, "worker %zu: unknown exception\n", rank);
+                    status = 1;
+                }
+                std::fflush(nullptr);
+                ::_exit(status);
+            }
+            children.push_back(pid);
+        }
+
+        // Polls only our own children, so other children of the caller (e.g. in
+        // an embedding interpreter) are left alone.
+        std::string failure;
+        size_t running = n_workers;
+        while (running > 0) {
+            bool reaped = false;
+            for (pid_t& child : children) {
+                if (child == 0) continue;
+                int status = 0;
+                const pid_t pid = ::waitpid(child, &status, WNOHANG);
+                if (pid == 0 || (pid < 0 && errno == EINTR)) continue;
+                child = 0;
+                --running;
+                reaped = true;
+                if (pid > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) continue;
+                if (failure.empty()) {
+                    failure = pid < 0 ? "lost track of the process"
+                            : WIFSIGNALED(status) ? "killed by signal " + std::to_string(WTERMSIG(status))
+                            : "exit status " + std::to_string(WEXITSTATUS(status));
+                }
+            }
+            if (!failure.empty()) {
+                terminate_all();
+                break;
+            }
+            if (!reaped) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        if (!failure.empty()) {
+            throw std::runtime_error("launch: a worker failed (" + failure + ")");
+        }
+    }
+
+}
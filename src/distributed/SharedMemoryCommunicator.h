@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "distributed/Communicator.h"
+
+namespace distributed {
+
+    // Allreduce between processes on one machine through a POSIX shared memory
+    // segment "/<name>". Each rank copies its vector into its own slot, then
+    // reduces one chunk across all slots (reduce-scatter) into a shared result
+    // that every rank copies back; two process-shared barriers separate the
+    // phases. Vectors longer than `capacity` are reduced in pieces.
+    //
+    // Rank 0 creates the segment and the other ranks attach to it, so ranks can
+    // be forked or started independently; the name is unlinked once all ranks
+    // have attached. An attaching rank writes a fresh token into its handshake
+    // entry and only proceeds once rank 0 echoes it back. A segment left by an
+    // earlier run never echoes, and the rank moves to the new segment as soon as
+    // rank 0 recreates the name.
+    class SharedMemoryCommunicator final : public Communicator {
+    public:
+        SharedMemoryCommunicator(const std::string& name, const size_t rank, const size_t size,
+                                 const size_t capacity = 1 << 20,
+                                 const std::chrono::milliseconds timeout = std::chrono::seconds(30))
+            : name_("/" + name), rank_(rank), size_(size), capacity_(capacity) {
+            if (size == 0 || rank >= size || capacity == 0) {
+                throw std::invalid_argument("SharedMemoryCommunicator: invalid rank, size or capacity");
+            }
+            bytes_ = data_offset() + (size_ + 1) * capacity_ * sizeof(double);
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            try {
+                if (rank_ == 0) {
+                    create();
+                    admit(deadline);
+                } else {
+                    attach(deadline);
+                }
+            } catch (...) {
+                if (rank_ == 0) ::shm_unlink(name_.c_str());
+                unmap();
+                throw;
+            }
+            barrier();
+            if (rank_ == 0) ::shm_unlink(name_.c_str());
+        }
+
+        ~SharedMemoryCommunicator() override {
+            unmap();
+        }
+
+        SharedMemoryCommunicator(const SharedMemoryCommunicator&) = delete;
+        SharedMemoryCommunicator& operator=(const SharedMemoryCommunicator&) = delete;
+
+        size_t rank() const override { return rank_; }
+        size_t size() const override { return size_; }
+
+        void allreduce(std::span<double> data) override {
+            for (size_t offset = 0; offset < data.size(); offset += capacity_) {
+                reduce_piece(data.subspan(offset, std::min(capacity_, data.size() - offset)));
+            }
+        }
+
+        void barrier() override {
+            const int result = pthread_barrier_wait(&header()->barrier);
+            if (result != 0 && result != PTHREAD_BARRIER_SERIAL_THREAD) {
+                throw std::system_error(result, std::generic_category(), "SharedMemoryCommunicator: barrier");
+            }
+        }
+
+    private:
+        static constexpr std::uint32_t ready_magic = 0x47445348; // "GDSH"
+
+        struct Header {
+            std::uint32_t ready;
+            std::uint32_t size;
+            std::uint64_t capacity;
+            pthread_barrier_t barrier;
+        };
+
+        // One per rank, right after the header. Rank 0 copies token into ack.
+        struct Handshake {
+            std::uint64_t token;
+            std::uint64_t ack;
+        };
+
+        using Clock = std::chrono::steady_clock;
+
+        std::string name_;
+        size_t rank_;
+        size_t size_;
+        size_t capacity_;
+        size_t bytes_ = 0;
+        void* base_ = nullptr;
+        // Identity of the mapped segment, to notice when the name is recreated.
+        dev_t device_ = 0;
+        ino_t inode_ = 0;
+
+        size_t data_offset() const {
+            return (sizeof(Header) + size_ * sizeof(Handshake) + 63) & ~size_t{63};
+        }
+
+        Header* header() const { return static_cast<Header*>(base_); }
+
+        std::atomic_ref<std::uint64_t> token(const size_t r) const {
+            return std::atomic_ref<std::uint64_t>(reinterpret_cast<Handshake*>(header() + 1)[r].token);
+        }
+
+        std::atomic_ref<std::uint64_t> ack(const size_t r) const {
+            return std::atomic_ref<std::uint64_t>(reinterpret_cast<Handshake*>(header() + 1)[r].ack);
+        }
+
+        std::uint32_t ready() const {
+            return std::atomic_ref<std::uint32_t>(header()->ready).load(std::memory_order_acquire);
+        }
+
+        // Slot r holds rank r's input; slot size_ holds the reduced result.
+        double* slot(const size_t r) const {
+            return reinterpret_cast<double*>(static_cast<char*>(base_) + data_offset()) + r * capacity_;
+        }
+
+        void reduce_piece(const std::span<double> piece) {
+            const size_t n = piece.size();
+            std::copy(piece.begin(), piece.end(), slot(rank_));
+            barrier();
+
+            // This rank owns elements [lo, hi) of the piece and sums them over the
+            // slots in rank order, so the result does not depend on timing.
+            const size_t chunk = (n + size_ - 1) / size_;
+            const size_t lo = std::min(n, rank_ * chunk);
+            const size_t hi = std::min(n, lo + chunk);
+            double* result = slot(size_);
+            for (size_t i = lo; i < hi; ++i) {
+                double total = 0;
+                for (size_t r = 0; r < size_; ++r) {
+                    total += slot(r)[i];
+                }
+                result[i] = total;
+            }
+            barrier();
+
+            std::copy(result, result + n, piece.begin());
+        }
+
+        void map(const int fd, const struct stat& info) {
+            base_ = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            const int error = errno;
+            ::close(fd);
+            if (base_ == MAP_FAILED) {
+                base_ = nullptr;
+                throw std::system_error(error, std::generic_category(), "SharedMemoryCommunicator: mmap " + name_);
+            }
+            device_ = info.st_dev;
+            inode_ = info.st_ino;
+        }
+
+        void unmap() {
+            if (base_) ::munmap(base_, bytes_);
+            base_ = nullptr;
+        }
+
+        void wait(const Clock::time_point deadline, const char* what) const {
+            if (Clock::now() > deadline) {
+                throw std::runtime_error(std::string("SharedMemoryCommunicator: timed out waiting for ") + what +
+                                         " on " + name_);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        void create() {
+            ::shm_unlink(name_.c_str()); // Left over from a crashed run
+            const int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "SharedMemoryCommunicator: shm_open " + name_);
+            }
+            if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0) {
+                const int error = errno;
+                ::close(fd);
+                ::shm_unlink(name_.c_str());
+                throw std::system_error(error, std::generic_category(), "SharedMemoryCommunicator: ftruncate " + name_);
+            }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                const int error = errno;
+                ::close(fd);
+                ::shm_unlink(name_.c_str());
+                throw std::system_error(error, std::generic_category(), "SharedMemoryCommunicator: fstat " + name_);
+            }
+            map(fd, info);
+
+            Header* h = header();
+            h->size = static_cast<std::uint32_t>(size_);
+            h->capacity = capacity_;
+            pthread_barrierattr_t attr;
+            pthread_barrierattr_init(&attr);
+            pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+            const int result = pthread_barrier_init(&h->barrier, &attr, static_cast<unsigned>(size_));
+            pthread_barrierattr_destroy(&attr);
+            if (result != 0) {
+                ::shm_unlink(name_.c_str());
+                throw std::system_error(result, std::generic_category(), "SharedMemoryCommunicator: barrier init");
+            }
+            std::atomic_ref<std::uint32_t>(h->ready).store(ready_magic, std::memory_order_release);
+        }
+
+        // Waits for every other rank's token, then echoes them all, so either
+        // every rank reaches the first barrier or none does.
+        void admit(const Clock::time_point deadline) {
+            for (size_t r = 1; r < size_; ++r) {
+                while (token(r).load(std::memory_order_acquire) == 0) {
+                    wait(deadline, "ranks to attach");
+                }
+            }
+            for (size_t r = 1; r < size_; ++r) {
+                ack(r).store(token(r).load(std::memory_order_acquire), std::memory_order_release);
+            }
+        }
+
+        // Maps the segment under the name, retrying on a new one whenever the
+        // mapped one turns out to be stale.
+        void attach(const Clock::time_point deadline) {
+            const std::uint64_t value = new_token();
+            while (true) {
+                open_segment(deadline);
+                if (handshake(value, deadline)) return;
+                unmap();
+            }
+        }
+
+        void open_segment(const Clock::time_point deadline) {
+            while (true) {
+                const int fd = ::shm_open(name_.c_str(), O_RDWR, 0600);
+                if (fd >= 0) {
+                    struct stat info {};
+                    if (::fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= bytes_) {
+                        map(fd, info);
+                        return;
+                    }
+                    ::close(fd);
+                } else if (errno != ENOENT) {
+                    throw std::system_error(errno, std::generic_category(), "SharedMemoryCommunicator: shm_open " + name_);
+                }
+                wait(deadline, "rank 0");
+            }
+        }
+
+        // Returns false if the mapped segment was replaced before rank 0
+        // acknowledged this rank. Rank 0 unlinks the name only after every rank
+        // has been acknowledged, so until then the name must keep naming it.
+        bool handshake(const std::uint64_t value, const Clock::time_point deadline) {
+            while (ready() != ready_magic) {
+                if (replaced()) return false;
+                wait(deadline, "rank 0");
+            }
+            if (header()->size != size_ || header()->capacity != capacity_) {
+                if (replaced()) return false;
+                throw std::runtime_error("SharedMemoryCommunicator: ranks disagree on size or capacity for " + name_);
+            }
+            token(rank_).store(value, std::memory_order_release);
+            while (ack(rank_).load(std::memory_order_acquire) != value) {
+                if (replaced()) return false;
+                wait(deadline, "rank 0");
+            }
+            return true;
+        }
+
+        bool replaced() const {
+            const int fd = ::shm_open(name_.c_str(), O_RDONLY, 0600);
+            if (fd < 0) {
+                if (errno == ENOENT) return true;
+                throw std::system_error(errno, std::generic_category(), "SharedMemoryCommunicator: shm_open " + name_);
+            }
+            struct stat info {};
+            const bool ok = ::fstat(fd, &info) == 0;
+            ::close(fd);
+            return !ok || info.st_dev != device_ || info.st_ino != inode_;
+        }
+
+        // Distinct per process; never 0, which marks an empty entry.
+        static std::uint64_t new_token() {
+            const auto now = static_cast<std::uint64_t>(Clock::now().time_since_epoch().count());
+            return ((static_cast<std::uint64_t>(::getpid()) << 32) ^ now) | 1;
+        }
+    };
+
+}
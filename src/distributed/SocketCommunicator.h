@@ -0,0 +1,261 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "distributed/Communicator.h"
+
+namespace distributed {
+
+    // Ring allreduce over stream sockets: each rank is connected to the next and
+    // the previous rank, and a vector is reduced in 2 (size - 1) steps of
+    // size-th chunks (reduce-scatter, then allgather), so every link carries
+    // about 2x the vector regardless of the number of ranks. Sends and receives
+    // of a step are interleaved with poll(), so large chunks cannot deadlock.
+    //
+    // Use unix_ring() for workers on one machine and tcp_ring() across machines.
+    class SocketCommunicator final : public Communicator {
+    public:
+        // Listens on <directory>/<name>-<rank>.sock.
+        static std::unique_ptr<SocketCommunicator> unix_ring(
+                const std::string& name, const size_t rank, const size_t size,
+                const std::string& directory = "/tmp",
+                const std::chrono::milliseconds timeout = std::chrono::seconds(30)) {
+            const auto path = [&](const size_t r) { return directory + "/" + name + "-" + std::to_string(r) + ".sock"; };
+            const std::string own = path(rank);
+            const sockaddr_un listen_address = unix_address(own);
+            const sockaddr_un next_address = unix_address(path((rank + 1) % size));
+
+            ::unlink(own.c_str());
+            auto comm = std::unique_ptr<SocketCommunicator>(new SocketCommunicator(rank, size));
+            comm->connect_ring(AF_UNIX, listen_address, next_address, timeout);
+            ::unlink(own.c_str());
+            return comm;
+        }
+
+        // hosts[r] is "host:port" where rank r listens.
+        static std::unique_ptr<SocketCommunicator> tcp_ring(
+                const std::vector<std::string>& hosts, const size_t rank,
+                const std::chrono::milliseconds timeout = std::chrono::seconds(30)) {
+            const size_t size = hosts.size();
+            if (rank >= size) {
+                throw std::invalid_argument("SocketCommunicator: rank out of range");
+            }
+            sockaddr_in listen_address = resolve(hosts[rank]);
+            listen_address.sin_addr.s_addr = htonl(INADDR_ANY);
+            const sockaddr_in next_address = resolve(hosts[(rank + 1) % size]);
+
+            auto comm = std::unique_ptr<SocketCommunicator>(new SocketCommunicator(rank, size));
+            comm->connect_ring(AF_INET, listen_address, next_address, timeout);
+            return comm;
+        }
+
+        ~SocketCommunicator() override {
+            if (next_fd_ >= 0) ::close(next_fd_);
+            if (prev_fd_ >= 0) ::close(prev_fd_);
+        }
+
+        SocketCommunicator(const SocketCommunicator&) = delete;
+        SocketCommunicator& operator=(const SocketCommunicator&) = delete;
+
+        size_t rank() const override { return rank_; }
+        size_t size() const override { return size_; }
+
+        void allreduce(const std::span<double> data) override {
+            if (size_ == 1 || data.empty()) return;
+
+            const size_t n = data.size();
+            const auto chunk_begin = [&](const size_t c) { return std::min(n, c * ((n + size_ - 1) / size_)); };
+            const auto chunk = [&](const size_t c) {
+                const size_t lo = chunk_begin(c % size_);
+                return data.subspan(lo, chunk_begin(c % size_ + 1) - lo);
+            };
+            scratch_.resize((n + size_ - 1) / size_);
+
+            // Reduce-scatter: after step s, chunk (rank - s - 1) holds the sum over
+            // s + 2 ranks; after size - 1 steps rank r owns the total of chunk r + 1.
+            for (size_t s = 0; s + 1 < size_; ++s) {
+                const auto send = chunk(rank_ + size_ - s);
+                const auto recv = chunk(rank_ + size_ - s - 1);
+                exchange(send, std::span<double>(scratch_.data(), recv.size()));
+                for (size_t i = 0; i < recv.size(); ++i) {
+                    recv[i] += scratch_[i];
+                }
+            }
+            // Allgather: pass the finished chunks around the ring.
+            for (size_t s = 0; s + 1 < size_; ++s) {
+                exchange(chunk(rank_ + 1 + size_ - s), chunk(rank_ + size_ - s));
+            }
+        }
+
+        // An allreduce with one element per rank: every chunk is non-empty, so
+        // each rank's result depends on (and waits for) all others.
+        void barrier() override {
+            std::vector<double> tokens(size_);
+            allreduce(tokens);
+        }
+
+    private:
+        size_t rank_;
+        size_t size_;
+        int next_fd_ = -1;
+        int prev_fd_ = -1;
+        std::vector<double> scratch_;
+
+        SocketCommunicator(const size_t rank, const size_t size) : rank_(rank), size_(size) {
+            if (size == 0 || rank >= size) {
+                throw std::invalid_argument("SocketCommunicator: invalid rank or size");
+            }
+        }
+
+        static sockaddr_un unix_address(const std::string& path) {
+            sockaddr_un address{};
+            if (path.size() >= sizeof(address.sun_path)) {
+                throw std::invalid_argument("SocketCommunicator: socket path too long: " + path);
+            }
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, path.c_str(), path.size());
+            return address;
+        }
+
+        static sockaddr_in resolve(const std::string& endpoint) {
+            const size_t colon = endpoint.rfind(':');
+            if (colon == std::string::npos) {
+                throw std::invalid_argument("SocketCommunicator: expected host:port, got " + endpoint);
+            }
+            addrinfo hints{};
+            hints.ai_family = AF_INET;
+            hints.ai_socktype = SOCK_STREAM;
+            addrinfo* found = nullptr;
+            const int result = ::getaddrinfo(endpoint.substr(0, colon).c_str(), endpoint.substr(colon + 1).c_str(),
+                                             &hints, &found);
+            if (result != 0 || !found) {
+                throw std::runtime_error("SocketCommunicator: cannot resolve " + endpoint + ": " + gai_strerror(result));
+            }
+            sockaddr_in address{};
+            std::memcpy(&address, found->ai_addr, sizeof(address));
+            ::freeaddrinfo(found);
+            return address;
+        }
+
+        static void check(const int result, const char* what) {
+            if (result < 0) {
+                throw std::system_error(errno, std::generic_category(), std::string("SocketCommunicator: ") + what);
+            }
+        }
+
+        // Listens, connects to the next rank (retrying until it listens) and
+        // accepts the previous one; ranks are checked with a small handshake.
+        template <typename Address>
+        void connect_ring(const int family, const Address& listen_address, const Address& next_address,
+                          const std::chrono::milliseconds timeout) {
+            if (size_ == 1) return;
+
+            const int listener = ::socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            check(listener, "socket");
+            try {
+                const int reuse = 1;
+                ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+                check(::bind(listener, reinterpret_cast<const sockaddr*>(&listen_address), sizeof(listen_address)), "bind");
+                check(::listen(listener, 1), "listen");
+
+                const auto deadline = std::chrono::steady_clock::now() + timeout;
+                while (true) {
+                    next_fd_ = ::socket(family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                    check(next_fd_, "socket");
+                    if (::connect(next_fd_, reinterpret_cast<const sockaddr*>(&next_address), sizeof(next_address)) == 0) break;
+                    ::close(next_fd_);
+                    next_fd_ = -1;
+                    if (std::chrono::steady_clock::now() > deadline) {
+                        throw std::runtime_error("SocketCommunicator: timed out connecting to rank " +
+                                                 std::to_string((rank_ + 1) % size_));
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+
+                pollfd waiting{listener, POLLIN, 0};
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                if (::poll(&waiting, 1, static_cast<int>(std::max<std::int64_t>(remaining.count(), 1))) <= 0) {
+                    throw std::runtime_error("SocketCommunicator: timed out waiting for rank " +
+                                             std::to_string((rank_ + size_ - 1) % size_));
+                }
+                prev_fd_ = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+                check(prev_fd_, "accept");
+            } catch (...) {
+                ::close(listener);
+                throw;
+            }
+            ::close(listener);
+
+            if (family == AF_INET) {
+                const int on = 1;
+                ::setsockopt(next_fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+                ::setsockopt(prev_fd_, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            }
+            ::fcntl(next_fd_, F_SETFL, ::fcntl(next_fd_, F_GETFL) | O_NONBLOCK);
+            ::fcntl(prev_fd_, F_SETFL, ::fcntl(prev_fd_, F_GETFL) | O_NONBLOCK);
+
+            double ranks[2] = {static_cast<double>(rank_), 0};
+            exchange(std::span<double>(ranks, 1), std::span<double>(ranks + 1, 1));
+            if (static_cast<size_t>(ranks[1]) != (rank_ + size_ - 1) % size_) {
+                throw std::runtime_error("SocketCommunicator: unexpected peer on rank " + std::to_string(rank_));
+            }
+        }
+
+        // Sends `out` to the next rank while receiving `in` from the previous one.
+        void exchange(const std::span<const double> out, const std::span<double> in) {
+            const char* send = reinterpret_cast<const char*>(out.data());
+            char* recv = reinterpret_cast<char*>(in.data());
+            size_t to_send = out.size_bytes();
+            size_t to_recv = in.size_bytes();
+
+            while (to_send > 0 || to_recv > 0) {
+                pollfd fds[2];
+                nfds_t count = 0;
+                if (to_send > 0) fds[count++] = {next_fd_, POLLOUT, 0};
+                if (to_recv > 0) fds[count++] = {prev_fd_, POLLIN, 0};
+                if (::poll(fds, count, -1) < 0) {
+                    if (errno == EINTR) continue;
+                    check(-1, "poll");
+                }
+
+                for (nfds_t i = 0; i < count; ++i) {
+                    if (fds[i].revents == 0) continue;
+                    if (fds[i].fd == next_fd_) {
+                        const ssize_t sent = ::send(next_fd_, send, to_send, MSG_NOSIGNAL);
+                        if (sent < 0 && errno != EAGAIN && errno != EINTR) check(-1, "send");
+                        if (sent > 0) {
+                            send += sent;
+                            to_send -= static_cast<size_t>(sent);
+                        }
+                    } else {
+                        const ssize_t got = ::recv(prev_fd_, recv, to_recv, 0);
+                        if (got == 0) throw std::runtime_error("SocketCommunicator: peer closed the connection");
+                        if (got < 0 && errno != EAGAIN && errno != EINTR) check(-1, "recv");
+                        if (got > 0) {
+                            recv += got;
+                            to_recv -= static_cast<size_t>(got);
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include "autodiff/variable/Variable.h"
+#include "data/MatrixView.h"
+#include "data/sparse/CsrMatrix.h"
+#include "loss/LossFunction.h"
+#include "parallel/ParallelFor.h"
+
+// Graph-free inference for the linear model trained by the optimizers:
+// prediction i is w[n] + sum_j w[j] * X[i][j], with the bias stored last.
+
+namespace inference {
+
+    // Rows handled per parallel block; small inputs run on the calling thread.
+    constexpr size_t grain_elements = 1 << 15;
+
+    // Dot product with independent per-lane accumulators, which the compiler can
+    // keep in vector registers without reassociating the sum.
+    template <autodiff::Scalar T>
+    autodiff::accumulate_t<T> dot(const T* x, const T* w, const size_t n) {
+        using Accum = autodiff::accumulate_t<T>;
+        constexpr size_t lanes = 8;
+        Accum acc[lanes] = {};
+
+        size_t j = 0;
+        for (; j + lanes <= n; j += lanes) {
+            for (size_t l = 0; l < lanes; ++l) {
+                acc[l] += static_cast<Accum>(x[j + l]) * w[j + l];
+            }
+        }
+        for (; j < n; ++j) {
+            acc[0] += static_cast<Accum>(x[j]) * w[j];
+        }
+
+        Accum total = 0;
+        for (const Accum a : acc) total += a;
+        return total;
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<T> values(const std::vector<autodiff::VariablePtr<T>>& w) {
+        std::vector<T> result;
+        result.reserve(w.size());
+        for (const auto& param : w) {
+            result.push_back(param->value());
+        }
+        return result;
+    }
+
+    // Computes y[i] for all rows, splitting rows across threads. row_at(i) returns
+    // a contiguous span with at least weights.size() - 1 features.
+    template <autodiff::Scalar T, typename RowAt>
+    void predict_rows(const std::vector<T>& weights, const size_t n_rows, RowAt&& row_at, std::span<T> y) {
+        if (weights.empty()) {
+            throw std::invalid_argument("predict: weights must include the bias");
+        }
+        const size_t n_features = weights.size() - 1;
+        const T bias = weights[n_features];
+        const size_t grain = std::max<size_t>(1, grain_elements / std::max<size_t>(n_features, 1));
+
+        parallel::parallel_for(0, n_rows, grain, [&](const size_t lo, const size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                const std::span<const T> row = row_at(i);
+                y[i] = static_cast<T>(bias + dot(row.data(), weights.data(), n_features));
+            }
+        });
+    }
+
+    template <autodiff::Scalar T>
+    void predict(const std::vector<T>& weights, const MatrixView<T>& X, std::span<T> y) {
+        if (X.cols + 1 < weights.size()) {
+            throw std::invalid_argument("predict: X has fewer columns than the model has features");
+        }
+        predict_rows(weights, X.rows, [&X](const size_t i) { return X.row(i); }, y);
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<T> predict(const std::vector<autodiff::VariablePtr<T>>& w, const std::vector<std::vector<T>>& X) {
+        for (const auto& row : X) {
+            if (row.size() + 1 < w.size()) {
+                throw std::invalid_argument("predict: a row of X has fewer values than the model has features");
+            }
+        }
+        std::vector<T> y(X.size());
+        predict_rows(values(w), X.size(), [&X](const size_t i) { return std::span<const T>(X[i]); }, std::span<T>(y));
+        return y;
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<T> predict(const std::vector<autodiff::VariablePtr<T>>& w, const MatrixView<T>& X) {
+        std::vector<T> y(X.rows);
+        predict(values(w), X, std::span<T>(y));
+        return y;
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<T> predict(const std::vector<autodiff::VariablePtr<T>>& w, const CsrMatrix<T>& X) {
+        using Accum = autodiff::accumulate_t<T>;
+        const std::vector<T> weights = values(w);
+        if (weights.empty()) {
+            throw std::invalid_argument("predict: weights must include the bias");
+        }
+        const size_t n_features = weights.size() - 1;
+        std::vector<T> y(X.rows());
+
+        parallel::parallel_for(0, X.rows(), grain_elements / 16, [&](const size_t lo, const size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                const auto row = X.row(i);
+                Accum total = weights[n_features];
+                for (size_t k = 0; k < row.nnz(); ++k) {
+                    if (row.indices[k] < n_features) {
+                        total += static_cast<Accum>(row.values[k]) * weights[row.indices[k]];
+                    }
+                }
+                y[i] = static_cast<T>(total);
+            }
+        });
+        return y;
+    }
+
+    template <autodiff::Scalar T>
+    size_t row_count(const MatrixView<T>& X) { return X.rows; }
+
+    template <autodiff::Scalar T>
+    size_t row_count(const std::vector<std::vector<T>>& X) { return X.size(); }
+
+    template <autodiff::Scalar T>
+    size_t row_count(const CsrMatrix<T>& X) { return X.rows(); }
+
+    template <autodiff::Scalar T, typename Features>
+    T evaluate(const std::vector<autodiff::VariablePtr<T>>& w, const Features& X,
+               const std::vector<T>& y_true, LossFunction<T>& loss_fn) {
+        if (y_true.size() != row_count(X)) {
+            throw std::invalid_argument("evaluate: X and y_true differ in row count");
+        }
+        return loss_fn.value(predict(w, X), y_true);
+    }
+
+}
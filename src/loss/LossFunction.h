@@ -1,11 +1,45 @@
 #pragma once
 #include <future>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include "autodiff/variable/Variable.h"
 
+template <autodiff::Scalar T = double>
 class LossFunction {
 public:
-    using Variable = std::shared_ptr<autodiff::Variable>;
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
     virtual ~LossFunction() = default;
-    virtual Variable compute(std::vector<Variable>& y_pred, const std::vector<double>& y_true) = 0;
+    virtual Variable compute(std::vector<Variable>& y_pred, const std::vector<T>& y_true) = 0;
+
+    // Loss value for plain predictions. The default builds a throwaway graph;
+    // losses override it with a direct computation.
+    virtual T value(const std::vector<T>& y_pred, const std::vector<T>& y_true) {
+        std::vector<Variable> leaves;
+        leaves.reserve(y_pred.size());
+        for (const T prediction : y_pred) {
+            leaves.push_back(autodiff::BasicVariable<T>::create(prediction));
+        }
+        return compute(leaves, y_true)->value();
+    }
+
+    // Loss value for plain predictions, with dL/dy_pred written into grad (one
+    // entry per prediction). The default differentiates compute() on throwaway
+    // leaves; losses override it with a direct computation.
+    virtual T gradient(const std::span<const T> y_pred, const std::vector<T>& y_true, const std::span<T> grad) {
+        if (grad.size() != y_pred.size()) {
+            throw std::invalid_argument("gradient: grad and y_pred differ in size");
+        }
+        std::vector<Variable> leaves;
+        leaves.reserve(y_pred.size());
+        for (const T prediction : y_pred) {
+            leaves.push_back(autodiff::BasicVariable<T>::create(prediction, true));
+        }
+        const auto loss = compute(leaves, y_true);
+        loss->backward();
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            grad[i] = static_cast<T>(leaves[i]->grad());
+        }
+        return loss->value();
+    }
 };
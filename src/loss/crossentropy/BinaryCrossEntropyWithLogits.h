@@ -0,0 +1,34 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include "autodiff/kernels/CrossEntropy.h"
+#include "loss/LossFunction.h"
+
+// Logistic loss on raw scores: y_pred are logits, y_true are targets in [0, 1].
+// Equivalent to binary cross-entropy of sigmoid(y_pred), but evaluated as one
+// stable node, so large logits neither overflow nor saturate the gradient.
+template <autodiff::Scalar T = double>
+class BinaryCrossEntropyWithLogits final : public LossFunction<T> {
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+public:
+    Variable compute(std::vector<Variable>& y_pred, const std::vector<T>& y_true) override {
+        return autodiff::sigmoid_cross_entropy(y_pred, y_true);
+    }
+
+    T value(const std::vector<T>& y_pred, const std::vector<T>& y_true) override {
+        const auto total = autodiff::kernels::sigmoid_cross_entropy<T>(y_pred, y_true);
+        return static_cast<T>(total / y_true.size());
+    }
+
+    T gradient(const std::span<const T> y_pred, const std::vector<T>& y_true, const std::span<T> grad) override {
+        if (grad.size() != y_pred.size()) {
+            throw std::invalid_argument("gradient: grad and y_pred differ in size");
+        }
+        const auto total = autodiff::kernels::sigmoid_cross_entropy<T>(y_pred, y_true, grad);
+        const autodiff::accumulate_t<T> scale = autodiff::accumulate_t<T>(1) / y_true.size();
+        for (T& g : grad) {
+            g = static_cast<T>(g * scale);
+        }
+        return static_cast<T>(total / y_true.size());
+    }
+};
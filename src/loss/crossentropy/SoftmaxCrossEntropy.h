@@ -0,0 +1,41 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include "autodiff/kernels/CrossEntropy.h"
+#include "loss/LossFunction.h"
+
+// Multi-class cross-entropy on raw scores. y_pred holds n_classes logits per
+// sample (sample-major), y_true one class index per sample. Softmax and the
+// log-likelihood are fused into one stable node.
+template <autodiff::Scalar T = double>
+class SoftmaxCrossEntropy final : public LossFunction<T> {
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+public:
+    explicit SoftmaxCrossEntropy(const size_t n_classes) : n_classes_(n_classes) {}
+
+    size_t n_classes() const { return n_classes_; }
+
+    Variable compute(std::vector<Variable>& y_pred, const std::vector<T>& y_true) override {
+        return autodiff::softmax_cross_entropy(y_pred, y_true, n_classes_);
+    }
+
+    T value(const std::vector<T>& y_pred, const std::vector<T>& y_true) override {
+        const auto total = autodiff::kernels::softmax_cross_entropy<T>(y_pred, y_true, n_classes_);
+        return static_cast<T>(total / y_true.size());
+    }
+
+    T gradient(const std::span<const T> y_pred, const std::vector<T>& y_true, const std::span<T> grad) override {
+        if (grad.size() != y_pred.size()) {
+            throw std::invalid_argument("gradient: grad and y_pred differ in size");
+        }
+        const auto total = autodiff::kernels::softmax_cross_entropy<T>(y_pred, y_true, n_classes_, grad);
+        const autodiff::accumulate_t<T> scale = autodiff::accumulate_t<T>(1) / y_true.size();
+        for (T& g : grad) {
+            g = static_cast<T>(g * scale);
+        }
+        return static_cast<T>(total / y_true.size());
+    }
+
+private:
+    size_t n_classes_;
+};
@@ -1,18 +1,53 @@
 #pragma once
+#include <span>
+#include <stdexcept>
 #include "loss/LossFunction.h"
 
-class MSE final : public LossFunction {
-    using Variable = std::shared_ptr<autodiff::Variable>;
+template <autodiff::Scalar T = double>
+class MSE final : public LossFunction<T> {
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
 public:
-    Variable compute(std::vector<Variable>& y_pred, const std::vector<double>& y_true) override {
-        auto loss = autodiff::Variable::create(0.0, true);
+    Variable compute(std::vector<Variable>& y_pred, const std::vector<T>& y_true) override {
+        check_sizes(y_pred.size(), y_true.size());
+        std::vector<Variable> squares;
+        squares.reserve(y_pred.size());
 
         for (size_t i = 0; i < y_pred.size(); ++i) {
-            auto y = autodiff::Variable::create(y_true[i]);
-            auto diff = y_pred[i] - y;
-            loss = loss + diff * diff;
+            auto diff = y_pred[i] - y_true[i];
+            squares.push_back(diff * diff);
         }
 
-        return loss / static_cast<double>(y_pred.size());
+        return autodiff::sum(squares) / static_cast<T>(y_pred.size());
+    }
+
+    T value(const std::vector<T>& y_pred, const std::vector<T>& y_true) override {
+        check_sizes(y_pred.size(), y_true.size());
+        autodiff::accumulate_t<T> total = 0;
+        for (size_t i = 0; i < y_pred.size(); ++i) {
+            const autodiff::accumulate_t<T> diff = y_pred[i] - y_true[i];
+            total += diff * diff;
+        }
+        return static_cast<T>(total / y_pred.size());
+    }
+
+    T gradient(const std::span<const T> y_pred, const std::vector<T>& y_true, const std::span<T> grad) override {
+        if (y_true.size() != y_pred.size() || grad.size() != y_pred.size()) {
+            throw std::invalid_argument("MSE: y_pred, y_true and grad differ in size");
+        }
+        const autodiff::accumulate_t<T> scale = autodiff::accumulate_t<T>(2) / y_pred.size();
+        autodiff::accumulate_t<T> total = 0;
+        for (size_t i = 0; i < y_pred.size(); ++i) {
+            const autodiff::accumulate_t<T> diff = y_pred[i] - y_true[i];
+            total += diff * diff;
+            grad[i] = static_cast<T>(scale * diff);
+        }
+        return static_cast<T>(total / y_pred.size());
+    }
+
+private:
+    static void check_sizes(const size_t n_pred, const size_t n_true) {
+        if (n_pred != n_true) {
+            throw std::invalid_argument("MSE: y_pred and y_true differ in size");
+        }
     }
 };
@@ -0,0 +1,124 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include "parallel/ParallelFor.h"
+
+// Cache-blocked matrix multiply for the model layers.
+
+namespace gemm {
+
+    // Tile sizes: a block_rows x block_depth panel of A and a block_depth x
+    // block_cols panel of B stay in L2 while a tile of C is updated.
+    constexpr size_t block_rows = 64;
+    constexpr size_t block_cols = 256;
+    constexpr size_t block_depth = 256;
+
+    // Products smaller than this many multiply-adds run on the calling thread.
+    constexpr size_t parallel_work = 1 << 18;
+
+    // Columns handled per step of the inner loops; the fixed trip count lets the
+    // compiler keep each step in vector registers.
+    constexpr size_t lanes = 8;
+
+    // C[i0:i1, j0:j1] += A[i0:i1, k0:k1] B[k0:k1, j0:j1]. Four rows of A share
+    // each loaded row of B, and the inner loops run over contiguous columns.
+    template <typename TA, typename TC>
+    void update_tile(const size_t i0, const size_t i1, const size_t j0, const size_t j1,
+                     const size_t k0, const size_t k1,
+                     const TA* A, const size_t lda, const TA* B, const size_t ldb, TC* C, const size_t ldc) {
+        const size_t width = j1 - j0;
+        const size_t vector_width = width - width % lanes;
+        size_t i = i0;
+        for (; i + 4 <= i1; i += 4) {
+            TC* __restrict c0 = C + i * ldc + j0;
+            TC* __restrict c1 = c0 + ldc;
+            TC* __restrict c2 = c1 + ldc;
+            TC* __restrict c3 = c2 + ldc;
+            for (size_t k = k0; k < k1; ++k) {
+                const TA* __restrict b = B + k * ldb + j0;
+                const TC a0 = A[i * lda + k];
+                const TC a1 = A[(i + 1) * lda + k];
+                const TC a2 = A[(i + 2) * lda + k];
+                const TC a3 = A[(i + 3) * lda + k];
+                size_t j = 0;
+                for (; j < vector_width; j += lanes) {
+                    for (size_t l = 0; l < lanes; ++l) {
+                        const TC bj = b[j + l];
+                        c0[j + l] += a0 * bj;
+                        c1[j + l] += a1 * bj;
+                        c2[j + l] += a2 * bj;
+                        c3[j + l] += a3 * bj;
+                    }
+                }
+                for (; j < width; ++j) {
+                    const TC bj = b[j];
+                    c0[j] += a0 * bj;
+                    c1[j] += a1 * bj;
+                    c2[j] += a2 * bj;
+                    c3[j] += a3 * bj;
+                }
+            }
+        }
+        for (; i < i1; ++i) {
+            TC* __restrict c = C + i * ldc + j0;
+            for (size_t k = k0; k < k1; ++k) {
+                const TA* __restrict b = B + k * ldb + j0;
+                const TC a = A[i * lda + k];
+                for (size_t j = 0; j < width; ++j) {
+                    c[j] += a * static_cast<TC>(b[j]);
+                }
+            }
+        }
+    }
+
+    // C (m x n) = A (m x k) B (k x n), or C += A B when `accumulate` is set. All
+    // matrices are row-major with leading dimensions lda, ldb and ldc. Tiles of C
+    // are distributed over n_threads threads (0 = all cores); each tile is owned
+    // by one thread, so no synchronisation is needed.
+    template <typename TA, typename TC>
+    void multiply(const size_t m, const size_t n, const size_t k,
+                  const TA* A, const size_t lda, const TA* B, const size_t ldb,
+                  TC* C, const size_t ldc, const bool accumulate, const size_t n_threads = 0) {
+        if (m == 0 || n == 0) return;
+
+        const size_t row_tiles = (m + block_rows - 1) / block_rows;
+        const size_t col_tiles = (n + block_cols - 1) / block_cols;
+        const size_t threads = m * n * k < parallel_work ? 1 : n_threads;
+
+        parallel::parallel_for(0, row_tiles * col_tiles, 1, [&](const size_t lo, const size_t hi) {
+            for (size_t tile = lo; tile < hi; ++tile) {
+                const size_t i0 = (tile / col_tiles) * block_rows;
+                const size_t j0 = (tile % col_tiles) * block_cols;
+                const size_t i1 = std::min(m, i0 + block_rows);
+                const size_t j1 = std::min(n, j0 + block_cols);
+
+                if (!accumulate) {
+                    for (size_t i = i0; i < i1; ++i) {
+                        std::fill(C + i * ldc + j0, C + i * ldc + j1, TC(0));
+                    }
+                }
+                for (size_t k0 = 0; k0 < k; k0 += block_depth) {
+                    update_tile(i0, i1, j0, j1, k0, std::min(k, k0 + block_depth), A, lda, B, ldb, C, ldc);
+                }
+            }
+        }, threads);
+    }
+
+    // dst (cols x rows) = src^T, where src is rows x cols with leading dimension ld.
+    template <typename T>
+    void transpose(const size_t rows, const size_t cols, const T* src, const size_t ld, T* dst) {
+        constexpr size_t block = 32;
+        for (size_t i0 = 0; i0 < rows; i0 += block) {
+            for (size_t j0 = 0; j0 < cols; j0 += block) {
+                const size_t i1 = std::min(rows, i0 + block);
+                const size_t j1 = std::min(cols, j0 + block);
+                for (size_t i = i0; i < i1; ++i) {
+                    for (size_t j = j0; j < j1; ++j) {
+                        dst[j * rows + i] = src[i * ld + j];
+                    }
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <span>
+#include <vector>
+#include "autodiff/variable/Variable.h"
+#include "data/MatrixView.h"
+
+// A differentiable function of a batch of rows with trainable parameters.
+// Models work on whole batches with dense kernels instead of per-scalar graph
+// nodes; their parameters are still Variables, so the optimizers update them
+// like any other weights. Not thread-safe: forward keeps the state backward needs.
+template <autodiff::Scalar T = double>
+class Model {
+public:
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+
+    virtual ~Model() = default;
+
+    virtual size_t in_features() const = 0;
+    virtual size_t out_features() const = 0;
+
+    // Evaluates the model on X (n x in_features). The result is n x out_features
+    // and stays valid until the next call to forward.
+    virtual MatrixView<T> forward(const MatrixView<T>& X) = 0;
+
+    // Given dL/dY for the last forward, adds dL/dparameter to the parameters'
+    // gradients and, if dX is non-empty, writes dL/dX (n x in_features) into it.
+    virtual void backward(const MatrixView<T>& dY, std::span<T> dX) = 0;
+
+    virtual std::vector<Variable> parameters() = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <algorithm>
+#include <stdexcept>
+#include "autodiff/kernels/Kernels.h"
+#include "model/Model.h"
+
+// Elementwise tanh, evaluated with the same vectorized kernel as
+// autodiff::tanh. dX = dY (1 - Y^2), from the cached output.
+template <autodiff::Scalar T = double>
+class Tanh final : public Model<T> {
+public:
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+
+    explicit Tanh(const size_t features) : features_(features) {}
+
+    size_t in_features() const override { return features_; }
+    size_t out_features() const override { return features_; }
+
+    MatrixView<T> forward(const MatrixView<T>& X) override {
+        if (X.cols != features_) {
+            throw std::invalid_argument("Tanh: input width does not match the layer");
+        }
+        output_.resize(X.rows * features_);
+        for (size_t i = 0; i < X.rows; ++i) {
+            const auto row = X.row(i);
+            std::copy(row.begin(), row.end(), output_.begin() + i * features_);
+        }
+        autodiff::kernels::tanh<T>(output_, output_);
+        return {output_.data(), X.rows, features_, features_};
+    }
+
+    void backward(const MatrixView<T>& dY, const std::span<T> dX) override {
+        if (dX.empty()) return;
+        if (dY.cols != features_ || dX.size() != output_.size() || dY.rows * features_ != output_.size()) {
+            throw std::invalid_argument("Tanh: gradient shape does not match the last forward");
+        }
+        for (size_t i = 0; i < dY.rows; ++i) {
+            const auto grad = dY.row(i);
+            const T* y = output_.data() + i * features_;
+            T* out = dX.data() + i * features_;
+            for (size_t j = 0; j < features_; ++j) {
+                out[j] = grad[j] * (1 - y[j] * y[j]);
+            }
+        }
+    }
+
+    std::vector<Variable> parameters() override { return {}; }
+
+private:
+    size_t features_;
+    std::vector<T> output_;
+};
@@ -0,0 +1,123 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "model/Gemm.h"
+#include "model/Model.h"
+
+// Fully connected layer: Y = X W^T + b with W stored out x in (row-major) and
+// one bias per output. Weights start Glorot-uniform from `seed`, biases at zero.
+// The kernels work on one contiguous block of parameter values and gradients:
+// forward copies the parameters' values into it, and backward computes the
+// gradients there and adds them to the parameters. Both copies are O(parameters),
+// small next to the O(batch x parameters) products.
+template <autodiff::Scalar T = double>
+class Dense final : public Model<T> {
+public:
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+    using Accum = autodiff::accumulate_t<T>;
+
+    Dense(const size_t in_features, const size_t out_features, const std::uint64_t seed = 0,
+          const size_t n_threads = 0)
+        : in_(in_features), out_(out_features), n_threads_(n_threads) {
+        if (in_ == 0 || out_ == 0) {
+            throw std::invalid_argument("Dense: layer sizes must be positive");
+        }
+        std::mt19937_64 rng(seed);
+        const double limit = std::sqrt(6.0 / static_cast<double>(in_ + out_));
+        std::uniform_real_distribution<double> init(-limit, limit);
+
+        const size_t n_weights = out_ * in_;
+        parameters_.reserve(n_weights + out_);
+        for (size_t i = 0; i < n_weights + out_; ++i) {
+            const T value = i < n_weights ? static_cast<T>(init(rng)) : T(0);
+            parameters_.push_back(autodiff::BasicVariable<T>::create(value, true));
+        }
+        values_.resize(n_weights + out_);
+        grads_.resize(n_weights + out_);
+    }
+
+    size_t in_features() const override { return in_; }
+    size_t out_features() const override { return out_; }
+
+    MatrixView<T> forward(const MatrixView<T>& X) override {
+        if (X.cols != in_) {
+            throw std::invalid_argument("Dense: expected " + std::to_string(in_) + " input features");
+        }
+        input_ = X;
+        const size_t n = X.rows;
+        for (size_t i = 0; i < parameters_.size(); ++i) {
+            values_[i] = parameters_[i]->value();
+        }
+        const T* bias = values_.data() + out_ * in_;
+
+        wt_.resize(in_ * out_);
+        gemm::transpose(out_, in_, values_.data(), in_, wt_.data());
+
+        output_.resize(n * out_);
+        gemm::multiply(n, out_, in_, X.data, X.stride, wt_.data(), out_, output_.data(), out_, false, n_threads_);
+        for (size_t i = 0; i < n; ++i) {
+            T* row = output_.data() + i * out_;
+            for (size_t j = 0; j < out_; ++j) {
+                row[j] += bias[j];
+            }
+        }
+        return {output_.data(), n, out_, out_};
+    }
+
+    void backward(const MatrixView<T>& dY, const std::span<T> dX) override {
+        const size_t n = input_.rows;
+        if (dY.rows != n || dY.cols != out_) {
+            throw std::invalid_argument("Dense: gradient shape does not match the last forward");
+        }
+
+        // dW = dY^T X and db, summed over the batch in the accumulate type.
+        Accum* grad_w = grads_.data();
+        Accum* grad_b = grad_w + out_ * in_;
+        dy_t_.resize(out_ * n);
+        gemm::transpose(n, out_, dY.data, dY.stride, dy_t_.data());
+        gemm::multiply(out_, in_, n, dy_t_.data(), n, input_.data, input_.stride, grad_w, in_, false, n_threads_);
+        for (size_t j = 0; j < out_; ++j) {
+            Accum total = 0;
+            const T* column = dy_t_.data() + j * n;
+            for (size_t i = 0; i < n; ++i) {
+                total += column[i];
+            }
+            grad_b[j] = total;
+        }
+        for (size_t i = 0; i < parameters_.size(); ++i) {
+            parameters_[i]->add_grad(grads_[i]);
+        }
+
+        // dX = dY W
+        if (!dX.empty()) {
+            if (dX.size() != n * in_) {
+                throw std::invalid_argument("Dense: input gradient has the wrong size");
+            }
+            gemm::multiply(n, in_, out_, dY.data, dY.stride, values_.data(), in_, dX.data(), in_, false,
+                           n_threads_);
+        }
+    }
+
+    // Weights (row-major, out x in) followed by the biases.
+    std::vector<Variable> parameters() override {
+        return parameters_;
+    }
+
+private:
+    size_t in_;
+    size_t out_;
+    size_t n_threads_;
+    std::vector<Variable> parameters_;
+    std::vector<T> values_;    // Parameter values as of the last forward
+    std::vector<Accum> grads_; // Scratch for the last backward's gradients
+
+    MatrixView<T> input_;
+    std::vector<T> wt_;
+    std::vector<T> output_;
+    std::vector<T> dy_t_;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include "model/Model.h"
+#include "model/activation/Tanh.h"
+#include "model/dense/Dense.h"
+
+// Chain of models applied in order; each layer's output feeds the next.
+template <autodiff::Scalar T = double>
+class Sequential final : public Model<T> {
+public:
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+
+    Sequential() = default;
+
+    // Multi-layer perceptron: Dense layers of the given sizes (inputs first,
+    // outputs last) with Tanh between them and a linear output layer.
+    static std::shared_ptr<Sequential> mlp(const std::vector<size_t>& sizes, const std::uint64_t seed = 0,
+                                           const size_t n_threads = 0) {
+        if (sizes.size() < 2) {
+            throw std::invalid_argument("Sequential::mlp: need at least input and output sizes");
+        }
+        auto model = std::make_shared<Sequential>();
+        for (size_t l = 0; l + 1 < sizes.size(); ++l) {
+            model->add(std::make_shared<Dense<T>>(sizes[l], sizes[l + 1], seed + l, n_threads));
+            if (l + 2 < sizes.size()) {
+                model->add(std::make_shared<Tanh<T>>(sizes[l + 1]));
+            }
+        }
+        return model;
+    }
+
+    void add(std::shared_ptr<Model<T>> layer) {
+        if (!layers_.empty() && layers_.back()->out_features() != layer->in_features()) {
+            throw std::invalid_argument("Sequential: layer input width does not match the previous output");
+        }
+        layers_.push_back(std::move(layer));
+        gradients_.resize(layers_.size());
+    }
+
+    const std::vector<std::shared_ptr<Model<T>>>& layers() const { return layers_; }
+
+    size_t in_features() const override { return layers_.empty() ? 0 : layers_.front()->in_features(); }
+    size_t out_features() const override { return layers_.empty() ? 0 : layers_.back()->out_features(); }
+
+    MatrixView<T> forward(const MatrixView<T>& X) override {
+        if (layers_.empty()) {
+            throw std::logic_error("Sequential: no layers");
+        }
+        MatrixView<T> current = X;
+        for (const auto& layer : layers_) {
+            current = layer->forward(current);
+        }
+        return current;
+    }
+
+    void backward(const MatrixView<T>& dY, const std::span<T> dX) override {
+        // gradients_[l] holds dL/d(input of layer l) for l > 0.
+        MatrixView<T> grad = dY;
+        for (size_t l = layers_.size(); l-- > 0;) {
+            std::span<T> grad_in = dX;
+            if (l > 0) {
+                gradients_[l].resize(grad.rows * layers_[l]->in_features());
+                grad_in = gradients_[l];
+            }
+            layers_[l]->backward(grad, grad_in);
+            if (l > 0) {
+                const size_t width = layers_[l]->in_features();
+                grad = {gradients_[l].data(), grad.rows, width, width};
+            }
+        }
+    }
+
+    std::vector<Variable> parameters() override {
+        std::vector<Variable> result;
+        for (const auto& layer : layers_) {
+            const auto params = layer->parameters();
+            result.insert(result.end(), params.begin(), params.end());
+        }
+        return result;
+    }
+
+private:
+    std::vector<std::shared_ptr<Model<T>>> layers_;
+    std::vector<std::vector<T>> gradients_;
+};
@@ -1,196 +1,870 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include <memory>
 
 // AutoDiff includes
 #include "autodiff/variable/Variable.h"
+#include "autodiff/kernels/Kernels.h"
 
 // Optimizer includes
 #include "loss/LossFunction.h"
 #include "loss/mse/MSE.h"
+#include "loss/crossentropy/BinaryCrossEntropyWithLogits.h"
+#include "loss/crossentropy/SoftmaxCrossEntropy.h"
 #include "optimizers/GradientDescent.h"
+#include "model/Model.h"
+#include "model/dense/Dense.h"
+#include "model/activation/Tanh.h"
+#include "model/sequential/Sequential.h"
+#include "data/sparse/CsrMatrix.h"
+#include "data/window/WindowedFeatures.h"
+#include "data/stream/DataSource.h"
+#include "data/stream/CsvSource.h"
+#include "data/stream/BinarySource.h"
+#include "data/stream/PrefetchSource.h"
 #include "optimizers/vanilla/Vanilla.h"
+#include "optimizers/sweep/Sweep.h"
+#include "optimizers/online/OnlineLearner.h"
+#include "optimizers/online/OnlineSGD.h"
+#include "optimizers/online/RecursiveLeastSquares.h"
+#include "inference/Inference.h"
+#include "checkpoint/Checkpoint.h"
+#include "distributed/Communicator.h"
+#include "distributed/DataParallel.h"
+#include "distributed/SharedMemoryCommunicator.h"
+#include "distributed/SocketCommunicator.h"
 
 namespace py = pybind11;
 
-PYBIND11_MODULE(gradientdescent, m) {
-    m.doc() = "Gradient descent optimization and automatic differentiation module";
+template <autodiff::Scalar T>
+using DenseArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+template <autodiff::Scalar T>
+MatrixView<T> as_view(const DenseArray<T>& X) {
+    if (X.ndim() != 2) {
+        throw std::invalid_argument("expected a 2-D array");
+    }
+    const auto rows = static_cast<size_t>(X.shape(0));
+    const auto cols = static_cast<size_t>(X.shape(1));
+    return {X.data(), rows, cols, cols};
+}
+
+// WindowedFeatures built over a NumPy series. The array is kept alive with the
+// features, since raw windows point into it.
+template <autodiff::Scalar T, typename Make>
+std::shared_ptr<WindowedFeatures<T>> windowed(const DenseArray<T>& series, Make&& make) {
+    if (series.ndim() != 1) {
+        throw std::invalid_argument("expected a 1-D series");
+    }
+    struct Owned {
+        DenseArray<T> series;
+        WindowedFeatures<T> features;
+    };
+    auto owned = std::make_shared<Owned>(Owned{series, make(std::span<const T>(series.data(), series.size()))});
+    return {owned, &owned->features};
+}
+
+// Read-only NumPy view of the data behind `owner`, without copying.
+template <autodiff::Scalar T>
+py::array_t<T> readonly_view(const T* data, const std::vector<py::ssize_t>& shape,
+                             const std::vector<py::ssize_t>& strides, const py::handle owner) {
+    py::array_t<T> result(shape, strides, data, owner);
+    result.attr("setflags")(py::arg("write") = false);
+    return result;
+}
+
+template <autodiff::Scalar T>
+void bind_precision(py::module_& m) {
+    using Variable = autodiff::BasicVariable<T>;
 
     // ======== AutoDiff Bindings ========
-    py::class_<autodiff::Variable, std::shared_ptr<autodiff::Variable>>(m, "Variable")
+    py::class_<Variable, std::shared_ptr<Variable>>(m, "Variable")
         .def_static("create",
-            [](const double value, const bool requires_grad = false) {
-                return autodiff::Variable::create(value, requires_grad);
+            [](const T value, const bool requires_grad = false) {
+                return Variable::create(value, requires_grad);
             },
             "Create a Variable with value and optional gradient requirement",
             py::arg("value"), py::arg("requires_grad") = false)
         
-        .def_property_readonly("value", &autodiff::Variable::value,
+        .def_property_readonly("value", &Variable::value,
             "Get the current value of the variable")
-        .def_property_readonly("grad", &autodiff::Variable::grad,
+        .def_property_readonly("grad", &Variable::grad,
             "Get the current gradient of the variable")
-        .def_property_readonly("requires_grad", &autodiff::Variable::requires_grad,
+        .def_property_readonly("requires_grad", &Variable::requires_grad,
             "Check if the variable requires gradient computation")
         
-        .def("set_value", &autodiff::Variable::set_value,
+        .def("set_value", &Variable::set_value,
             "Set the value of the variable",
             py::arg("new_value"))
-        .def("set_grad", &autodiff::Variable::set_grad,
+        .def("set_grad", &Variable::set_grad,
             "Set the gradient of the variable",
             py::arg("grad"))
-        .def("zero_grad", &autodiff::Variable::zero_grad,
+        .def("zero_grad", &Variable::zero_grad,
             "Reset the gradient to zero")
-        .def("add_grad", &autodiff::Variable::add_grad,
+        .def("add_grad", &Variable::add_grad,
             "Add to the current gradient",
             py::arg("grad"))
         
-        .def("backward", &autodiff::Variable::backward,
+        .def("backward", &Variable::backward,
             "Compute gradients via backpropagation")
         
         .def("__add__",
-            [](const std::shared_ptr<autodiff::Variable>& self, const std::shared_ptr<autodiff::Variable>& other) {
+            [](const std::shared_ptr<Variable>& self, const std::shared_ptr<Variable>& other) {
                 return self->operator+(other);
             })
         .def("__sub__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const std::shared_ptr<autodiff::Variable>& other) {
+            [](const std::shared_ptr<Variable>& self, const std::shared_ptr<Variable>& other) {
                 return self->operator-(other);
             })
         .def("__mul__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const std::shared_ptr<autodiff::Variable>& other) {
+            [](const std::shared_ptr<Variable>& self, const std::shared_ptr<Variable>& other) {
                 return self->operator*(other);
             })
         .def("__truediv__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const std::shared_ptr<autodiff::Variable>& other) {
+            [](const std::shared_ptr<Variable>& self, const std::shared_ptr<Variable>& other) {
                 return self->operator/(other);
             })
         .def("__neg__", 
-            [](const std::shared_ptr<autodiff::Variable>& self) {
+            [](const std::shared_ptr<Variable>& self) {
                 return self->operator-();
             })
         
         .def("__add__",
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator+(self, other);
             })
         .def("__radd__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator+(other, self);
             })
         .def("__sub__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator-(self, other);
             })
         .def("__rsub__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator-(other, self);
             })
         .def("__mul__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator*(self, other);
             })
         .def("__rmul__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator*(other, self);
             })
         .def("__truediv__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator/(self, other);
             })
         .def("__rtruediv__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::operator/(other, self);
             })
         
-        .def("exp", &autodiff::Variable::exp,
+        .def("exp", &Variable::exp,
             "Compute exponential function")
-        .def("log", &autodiff::Variable::log,
+        .def("log", &Variable::log,
             "Compute natural logarithm")
-        .def("pow", &autodiff::Variable::pow,
+        .def("pow", &Variable::pow,
             "Compute power function",
             py::arg("exponent"))
-        .def("tanh", &autodiff::Variable::tanh,
+        .def("tanh", &Variable::tanh,
             "Compute hyperbolic tangent")
-        .def("sin", &autodiff::Variable::sin,
+        .def("sin", &Variable::sin,
             "Compute sine function")
-        .def("cos", &autodiff::Variable::cos,
+        .def("cos", &Variable::cos,
             "Compute cosine function")
         
         .def("__pow__",
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::pow(self, other);
             })
         .def("__rpow__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const double other) {
+            [](const std::shared_ptr<Variable>& self, const T other) {
                 return autodiff::pow(other, self);
             })
         .def("__pow__", 
-            [](const std::shared_ptr<autodiff::Variable>& self, const std::shared_ptr<autodiff::Variable> &other) {
+            [](const std::shared_ptr<Variable>& self, const std::shared_ptr<Variable> &other) {
                 return autodiff::pow(self, other);
             })
         
-        .def("print", &autodiff::Variable::print,
+        .def("print", &Variable::print,
             "Print the variable's value and gradient")
         
         .def("__repr__",
-            [](const autodiff::Variable& v) {
+            [](const Variable& v) {
                 return "Variable(value=" + std::to_string(v.value()) + 
                        ", grad=" + std::to_string(v.grad()) + 
                        ", requires_grad=" + (v.requires_grad() ? "True" : "False") + ")";
             })
         .def("__str__", 
-            [](const autodiff::Variable& v) {
+            [](const Variable& v) {
                 return "Variable(" + std::to_string(v.value()) + ")";
             })
         .def("__format__",
-            [](const autodiff::Variable& v, const std::string& format_spec) {
+            [](const Variable& v, const std::string& format_spec) {
                 return std::to_string(v.value());
             });
 
     // AutoDiff math functions
-    m.def("exp", [](const std::shared_ptr<autodiff::Variable>& x) { return x->exp(); },
+    m.def("exp", [](const std::shared_ptr<Variable>& x) { return x->exp(); },
         "Compute exponential function", py::arg("x"));
     
-    m.def("log", [](const std::shared_ptr<autodiff::Variable>& x) { return x->log(); },
+    m.def("log", [](const std::shared_ptr<Variable>& x) { return x->log(); },
         "Compute natural logarithm", py::arg("x"));
     
-    m.def("sin", [](const std::shared_ptr<autodiff::Variable>& x) { return x->sin(); },
+    m.def("sin", [](const std::shared_ptr<Variable>& x) { return x->sin(); },
         "Compute sine function", py::arg("x"));
     
-    m.def("cos", [](const std::shared_ptr<autodiff::Variable>& x) { return x->cos(); },
+    m.def("cos", [](const std::shared_ptr<Variable>& x) { return x->cos(); },
         "Compute cosine function", py::arg("x"));
     
-    m.def("tanh", [](const std::shared_ptr<autodiff::Variable>& x) { return x->tanh(); },
+    m.def("tanh", [](const std::shared_ptr<Variable>& x) { return x->tanh(); },
         "Compute hyperbolic tangent", py::arg("x"));
     
-    m.def("pow", [](const std::shared_ptr<autodiff::Variable>& base, const double exponent) {
+    // Batched versions: a list of Variables in, a list out, computed with the vectorized kernels
+    using Batch = std::vector<std::shared_ptr<Variable>>;
+    m.def("exp", [](const Batch& x) { return autodiff::exp(x); },
+        "Elementwise exponential of a list of Variables", py::arg("x"));
+    m.def("log", [](const Batch& x) { return autodiff::log(x); },
+        "Elementwise natural logarithm of a list of Variables", py::arg("x"));
+    m.def("sin", [](const Batch& x) { return autodiff::sin(x); },
+        "Elementwise sine of a list of Variables", py::arg("x"));
+    m.def("cos", [](const Batch& x) { return autodiff::cos(x); },
+        "Elementwise cosine of a list of Variables", py::arg("x"));
+    m.def("tanh", [](const Batch& x) { return autodiff::tanh(x); },
+        "Elementwise hyperbolic tangent of a list of Variables", py::arg("x"));
+
+    // Plain arrays, no graph: numpy array in, array of the same shape out
+    auto kernels = m.def_submodule("kernels", "Vectorized elementwise functions on arrays");
+    const auto bind_kernel = [&kernels](const char* name, void (*kernel)(std::span<const T>, std::span<T>),
+                                        const char* doc) {
+        kernels.def(name, [kernel](const DenseArray<T>& x) {
+            DenseArray<T> out(std::vector<py::ssize_t>(x.shape(), x.shape() + x.ndim()));
+            const auto n = static_cast<size_t>(x.size());
+            const T* in = x.data();
+            T* result = out.mutable_data();
+            {
+                py::gil_scoped_release release;
+                kernel(std::span<const T>(in, n), std::span<T>(result, n));
+            }
+            return out;
+        }, doc, py::arg("x"));
+    };
+    bind_kernel("exp", autodiff::kernels::exp<T>, "Elementwise exponential");
+    bind_kernel("log", autodiff::kernels::log<T>, "Elementwise natural logarithm");
+    bind_kernel("tanh", autodiff::kernels::tanh<T>, "Elementwise hyperbolic tangent");
+    bind_kernel("sin", autodiff::kernels::sin<T>, "Elementwise sine");
+    bind_kernel("cos", autodiff::kernels::cos<T>, "Elementwise cosine");
+    kernels.def("isa", &autodiff::kernels::isa, "Instruction set selected for the kernels");
+
+    m.def("pow", [](const std::shared_ptr<Variable>& base, const T exponent) {
         return autodiff::pow(base, exponent); 
     }, "Compute power function", py::arg("base"), py::arg("exponent"));
     
-    m.def("pow", [](const double base, const std::shared_ptr<autodiff::Variable>& exponent) {
+    m.def("pow", [](const T base, const std::shared_ptr<Variable>& exponent) {
         return autodiff::pow(base, exponent); 
     }, "Compute power function", py::arg("base"), py::arg("exponent"));
 
     // ======== Optimizer Bindings ========
     
     // Bind LossFunction base class (abstract)
-    py::class_<LossFunction, std::shared_ptr<LossFunction>>(m, "LossFunction")
-        .def("compute", &LossFunction::compute, "Compute the loss value",
+    py::class_<LossFunction<T>, std::shared_ptr<LossFunction<T>>>(m, "LossFunction")
+        .def("compute", &LossFunction<T>::compute, "Compute the loss value",
+             py::arg("y_pred"), py::arg("y_true"))
+        .def("value", &LossFunction<T>::value, "Compute the loss value for plain predictions",
+             py::arg("y_pred"), py::arg("y_true"))
+        .def("gradient",
+             [](LossFunction<T>& loss, const std::vector<T>& y_pred, const std::vector<T>& y_true) {
+                 std::vector<T> grad(y_pred.size());
+                 const T value = loss.gradient(y_pred, y_true, grad);
+                 return py::make_tuple(value, grad);
+             },
+             "Return (loss, dloss/dy_pred) for plain predictions",
              py::arg("y_pred"), py::arg("y_true"));
 
     // Bind MSE loss function
-    py::class_<MSE, LossFunction, std::shared_ptr<MSE>>(m, "MSE")
+    py::class_<MSE<T>, LossFunction<T>, std::shared_ptr<MSE<T>>>(m, "MSE")
+        .def(py::init<>())
+        .def("compute", &MSE<T>::compute, "Compute the mean squared error loss",
+             py::arg("y_pred"), py::arg("y_true"));
+
+    // Bind fused classification losses
+    py::class_<BinaryCrossEntropyWithLogits<T>, LossFunction<T>, std::shared_ptr<BinaryCrossEntropyWithLogits<T>>>(
+            m, "BinaryCrossEntropyWithLogits")
         .def(py::init<>())
-        .def("compute", &MSE::compute, "Compute the mean squared error loss",
+        .def("compute", &BinaryCrossEntropyWithLogits<T>::compute,
+             "Compute the mean logistic loss of logits against 0/1 targets",
              py::arg("y_pred"), py::arg("y_true"));
 
+    py::class_<SoftmaxCrossEntropy<T>, LossFunction<T>, std::shared_ptr<SoftmaxCrossEntropy<T>>>(
+            m, "SoftmaxCrossEntropy")
+        .def(py::init<size_t>(), py::arg("n_classes"))
+        .def_property_readonly("n_classes", &SoftmaxCrossEntropy<T>::n_classes)
+        .def("compute", &SoftmaxCrossEntropy<T>::compute,
+             "Compute the mean cross-entropy of n_classes logits per sample against class indices",
+             py::arg("y_pred"), py::arg("y_true"));
+
+    // ======== Model Bindings ========
+    py::class_<Model<T>, std::shared_ptr<Model<T>>>(m, "Model")
+        .def_property_readonly("in_features", &Model<T>::in_features)
+        .def_property_readonly("out_features", &Model<T>::out_features)
+        .def("predict",
+             [](Model<T>& self, const DenseArray<T>& X) {
+                 const auto view = as_view(X);
+                 DenseArray<T> result({static_cast<py::ssize_t>(view.rows),
+                                       static_cast<py::ssize_t>(self.out_features())});
+                 {
+                     py::gil_scoped_release release;
+                     const auto y = self.forward(view);
+                     std::copy(y.data, y.data + y.rows * y.cols, result.mutable_data());
+                 }
+                 return result;
+             },
+             "Evaluate the model on a 2-D array; returns an (n, out_features) array",
+             py::arg("X"))
+        .def("predict",
+             [](Model<T>& self, const WindowedFeatures<T>& windows, const size_t begin, const size_t end) {
+                 const auto view = windows.features(begin, end);
+                 DenseArray<T> result({static_cast<py::ssize_t>(view.rows),
+                                       static_cast<py::ssize_t>(self.out_features())});
+                 {
+                     py::gil_scoped_release release;
+                     const auto y = self.forward(view);
+                     std::copy(y.data, y.data + y.rows * y.cols, result.mutable_data());
+                 }
+                 return result;
+             },
+             "Evaluate the model on windows [begin, end) read in place",
+             py::arg("windows"), py::arg("begin") = 0, py::arg("end") = WindowedFeatures<T>::all)
+        .def("parameters", &Model<T>::parameters, "Trainable parameters as Variables");
+
+    py::class_<Dense<T>, Model<T>, std::shared_ptr<Dense<T>>>(m, "Dense")
+        .def(py::init<size_t, size_t, std::uint64_t, size_t>(),
+             py::arg("in_features"), py::arg("out_features"), py::arg("seed") = 0, py::arg("n_threads") = 0);
+
+    py::class_<Tanh<T>, Model<T>, std::shared_ptr<Tanh<T>>>(m, "Tanh")
+        .def(py::init<size_t>(), py::arg("features"));
+
+    py::class_<Sequential<T>, Model<T>, std::shared_ptr<Sequential<T>>>(m, "Sequential")
+        .def(py::init<>())
+        .def_static("mlp", &Sequential<T>::mlp,
+             "Dense layers of the given sizes with Tanh between them",
+             py::arg("sizes"), py::arg("seed") = 0, py::arg("n_threads") = 0)
+        .def("add", &Sequential<T>::add, "Append a layer", py::arg("layer"))
+        .def_property_readonly("layers", &Sequential<T>::layers);
+
+    // Bind sparse CSR matrix
+    py::class_<CsrMatrix<T>>(m, "CsrMatrix")
+        .def(py::init([](py::array_t<T, py::array::c_style | py::array::forcecast> data,
+                         py::array_t<int64_t, py::array::c_style | py::array::forcecast> indices,
+                         py::array_t<int64_t, py::array::c_style | py::array::forcecast> indptr,
+                         const std::pair<size_t, size_t> shape) {
+                return CsrMatrix<T>(shape.first, shape.second,
+                                    std::vector<size_t>(indptr.data(), indptr.data() + indptr.size()),
+                                    std::vector<size_t>(indices.data(), indices.data() + indices.size()),
+                                    std::vector<T>(data.data(), data.data() + data.size()));
+            }),
+            "Create a CSR matrix from data, indices, indptr and shape arrays",
+            py::arg("data"), py::arg("indices"), py::arg("indptr"), py::arg("shape"))
+        .def_static("from_scipy",
+            [](const py::object& matrix) {
+                const py::object csr = matrix.attr("tocsr")();
+                const auto shape = csr.attr("shape").cast<std::pair<size_t, size_t>>();
+                auto data = csr.attr("data").cast<py::array_t<T, py::array::c_style | py::array::forcecast>>();
+                auto indices = csr.attr("indices").cast<py::array_t<int64_t, py::array::c_style | py::array::forcecast>>();
+                auto indptr = csr.attr("indptr").cast<py::array_t<int64_t, py::array::c_style | py::array::forcecast>>();
+                return CsrMatrix<T>(shape.first, shape.second,
+                                    std::vector<size_t>(indptr.data(), indptr.data() + indptr.size()),
+                                    std::vector<size_t>(indices.data(), indices.data() + indices.size()),
+                                    std::vector<T>(data.data(), data.data() + data.size()));
+            },
+            "Create a CSR matrix from any scipy.sparse matrix",
+            py::arg("matrix"))
+        .def_static("from_dense", &CsrMatrix<T>::from_dense,
+            "Create a CSR matrix from a dense list of rows",
+            py::arg("dense"))
+        .def_property_readonly("shape",
+            [](const CsrMatrix<T>& X) { return std::make_pair(X.rows(), X.cols()); })
+        .def_property_readonly("nnz", &CsrMatrix<T>::nnz);
+
+    // Bind lag-window features
+    using Windows = WindowedFeatures<T>;
+    py::class_<Windows, std::shared_ptr<Windows>>(m, "WindowedFeatures")
+        .def_static("raw",
+            [](const DenseArray<T>& series, const size_t window) {
+                return windowed<T>(series, [&](const std::span<const T> s) { return Windows::raw(s, window); });
+            },
+            "Lag windows over the series as-is",
+            py::arg("series"), py::arg("window"))
+        .def_static("standardized",
+            [](const DenseArray<T>& series, const size_t window, const size_t train_rows) {
+                return windowed<T>(series, [&](const std::span<const T> s) {
+                    return Windows::standardized(s, window, train_rows);
+                });
+            },
+            "Lag windows over the series standardized with the statistics of the first train_rows rows",
+            py::arg("series"), py::arg("window"), py::arg("train_rows") = Windows::all)
+        .def_static("rolling",
+            [](const DenseArray<T>& series, const size_t window, const size_t lookback) {
+                return windowed<T>(series, [&](const std::span<const T> s) {
+                    return Windows::rolling(s, window, lookback);
+                });
+            },
+            "Lag windows over the series standardized by the statistics of the lookback points before each point",
+            py::arg("series"), py::arg("window"), py::arg("lookback"))
+        .def_property_readonly("rows", &Windows::rows)
+        .def_property_readonly("window", &Windows::window)
+        .def_property_readonly("offset", &Windows::offset, "Index in the series of row 0's first feature")
+        .def_property_readonly("X",
+            [](const py::object& self) {
+                const auto view = self.cast<const Windows&>().features();
+                return readonly_view<T>(view.data, {static_cast<py::ssize_t>(view.rows), static_cast<py::ssize_t>(view.cols)},
+                                        {sizeof(T), sizeof(T)}, self);
+            },
+            "(rows, window) read-only array sharing memory with the series")
+        .def_property_readonly("y",
+            [](const py::object& self) {
+                const auto targets = self.cast<const Windows&>().targets();
+                return readonly_view<T>(targets.data(), {static_cast<py::ssize_t>(targets.size())}, {sizeof(T)}, self);
+            },
+            "Targets, read-only and sharing memory with the series")
+        .def("denormalize",
+            [](const Windows& self, const DenseArray<T>& y, const size_t first_row) {
+                DenseArray<T> result(y.request().shape);
+                std::copy(y.data(), y.data() + y.size(), result.mutable_data());
+                self.denormalize(std::span<T>(result.mutable_data(), static_cast<size_t>(result.size())), first_row);
+                return result;
+            },
+            "Map predictions for rows first_row, first_row + 1, ... back to the scale of the series",
+            py::arg("y"), py::arg("first_row") = 0);
+
+    // Bind streaming data sources
+    py::class_<DataSource<T>, std::shared_ptr<DataSource<T>>>(m, "DataSource")
+        .def("reset", &DataSource<T>::reset, "Rewind to the first row")
+        .def_property_readonly("n_features", &DataSource<T>::n_features);
+
+    py::class_<CsvSource<T>, DataSource<T>, std::shared_ptr<CsvSource<T>>>(m, "CsvSource")
+        .def(py::init([](const std::string& path, const size_t chunk_rows, const py::object& target_column,
+                         const bool has_header) {
+                const size_t target = target_column.is_none() ? CsvSource<T>::last_column : target_column.cast<size_t>();
+                return std::make_shared<CsvSource<T>>(path, chunk_rows, target, has_header);
+            }),
+            "Read numeric CSV rows in chunks; the target defaults to the last column",
+            py::arg("path"), py::arg("chunk_rows") = 65536, py::arg("target_column") = py::none(),
+            py::arg("has_header") = true);
+
+    py::class_<BinarySource<T>, DataSource<T>, std::shared_ptr<BinarySource<T>>>(m, "BinarySource")
+        .def(py::init<std::string, size_t>(),
+            "Read a binary dataset written by BinarySource.write in chunks",
+            py::arg("path"), py::arg("chunk_rows") = 65536)
+        .def_static("write", &BinarySource<T>::write, "Write X and y as a binary dataset",
+            py::arg("path"), py::arg("X"), py::arg("y"))
+        .def_property_readonly("n_rows", &BinarySource<T>::n_rows);
+
+    py::class_<PrefetchSource<T>, DataSource<T>, std::shared_ptr<PrefetchSource<T>>>(m, "PrefetchSource")
+        .def(py::init<std::shared_ptr<DataSource<T>>>(),
+            "Read the next chunk on a background thread while the current one trains",
+            py::arg("source"));
+
+    // Bind checkpointing
+    py::class_<checkpoint::AsyncCheckpointer<T>, std::shared_ptr<checkpoint::AsyncCheckpointer<T>>>(m, "AsyncCheckpointer")
+        .def(py::init<std::string>(), "Write checkpoints to `path` on a background thread", py::arg("path"))
+        .def("flush", &checkpoint::AsyncCheckpointer<T>::flush, "Wait until pending checkpoints are written",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("path", &checkpoint::AsyncCheckpointer<T>::file);
+
+    py::class_<typename GradientDescent<T>::History>(m, "History")
+        .def_readonly("loss", &GradientDescent<T>::History::loss)
+        .def_readonly("validation_loss", &GradientDescent<T>::History::validation_loss)
+        .def_readonly("best_epoch", &GradientDescent<T>::History::best_epoch)
+        .def_readonly("stopped_early", &GradientDescent<T>::History::stopped_early);
+
     // Bind GradientDescent base class (abstract)
-    py::class_<GradientDescent, std::shared_ptr<GradientDescent>>(m, "GradientDescent")
-        .def("train", &GradientDescent::train, "Train the model using gradient descent",
-             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"));
+    py::class_<GradientDescent<T>, std::shared_ptr<GradientDescent<T>>>(m, "GradientDescent")
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const typename GradientDescent<T>::Matrix&,
+                               const std::vector<T>&, LossFunction<T>&, const T&>(&GradientDescent<T>::train),
+             "Train the model using gradient descent; returns the loss before the update",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const CsrMatrix<T>&,
+                               const std::vector<T>&, LossFunction<T>&, const T&>(&GradientDescent<T>::train),
+             "Train on a sparse CSR matrix; cost and updates scale with the nonzeros",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, DataSource<T>&,
+                               LossFunction<T>&, const T&>(&GradientDescent<T>::train),
+             "Train for one pass over a streamed data source, one step per chunk",
+             py::arg("w"), py::arg("source"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("train",
+             [](GradientDescent<T>& self, Model<T>& model, const DenseArray<T>& X, const std::vector<T>& y_true,
+                LossFunction<T>& loss_fn, const T learning_rate) {
+                 return self.train(model, as_view(X), y_true, loss_fn, learning_rate);
+             },
+             "Train a Model for one full-batch step; returns the loss before the update",
+             py::arg("model"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             [](GradientDescent<T>& self, Model<T>& model, const WindowedFeatures<T>& windows, LossFunction<T>& loss_fn,
+                const T learning_rate, const size_t begin, const size_t end) {
+                 const auto targets = windows.targets(begin, end);
+                 const std::vector<T> y_true(targets.begin(), targets.end());
+                 py::gil_scoped_release release;
+                 return self.train(model, windows.features(begin, end), y_true, loss_fn, learning_rate);
+             },
+             "Train a Model for one step on windows [begin, end) read in place",
+             py::arg("model"), py::arg("windows"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::arg("begin") = 0, py::arg("end") = WindowedFeatures<T>::all)
+        .def("compute_gradients",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const typename GradientDescent<T>::Matrix&,
+                               const std::vector<T>&, LossFunction<T>&>(&GradientDescent<T>::compute_gradients),
+             "Accumulate the gradients of a full batch without updating; returns the loss",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"))
+        .def("step", &GradientDescent<T>::step, "Apply the accumulated gradients and reset them",
+             py::arg("w"), py::arg("learning_rate"))
+        .def("fit",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const typename GradientDescent<T>::Matrix&,
+                               const std::vector<T>&, LossFunction<T>&, const T&, size_t>(&GradientDescent<T>::fit),
+             "Train for several epochs and return the loss of each epoch",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::arg("epochs"), py::call_guard<py::gil_scoped_release>())
+        .def("fit",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, DataSource<T>&,
+                               LossFunction<T>&, const T&, size_t>(&GradientDescent<T>::fit),
+             "Train for several passes over a streamed data source",
+             py::arg("w"), py::arg("source"), py::arg("loss_fn"), py::arg("learning_rate"), py::arg("epochs"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("set_validation", &GradientDescent<T>::set_validation,
+             "Validate on (X, y_true) in the background during fit, with optional early stopping",
+             py::arg("X"), py::arg("y_true"), py::arg("patience") = 0, py::arg("min_delta") = 0)
+        .def("clear_validation", &GradientDescent<T>::clear_validation, "Remove the validation set")
+        .def_property_readonly("history", &GradientDescent<T>::history,
+             "Training and validation losses recorded by fit")
+        .def("clear_history", &GradientDescent<T>::clear_history, "Reset the recorded losses")
+        .def_property("epoch", &GradientDescent<T>::epoch, &GradientDescent<T>::set_epoch,
+             "Number of epochs completed by fit")
+        .def("set_checkpointer", &GradientDescent<T>::set_checkpointer,
+             "Write a checkpoint in the background every `checkpoint_every` epochs of fit",
+             py::arg("checkpointer"), py::arg("checkpoint_every") = 1)
+        .def("save_checkpoint", &GradientDescent<T>::save_checkpoint,
+             "Write parameters, optimizer state and epoch counter to a checkpoint file",
+             py::arg("path"), py::arg("w"))
+        .def("restore",
+             [](GradientDescent<T>& self, const std::string& path, std::vector<std::shared_ptr<Variable>> w) {
+                 self.restore(path, w);
+                 return w;
+             },
+             "Restore from a checkpoint file and return the parameters",
+             py::arg("path"), py::arg("w") = std::vector<std::shared_ptr<Variable>>{})
+        .def("set_master_weights", &GradientDescent<T>::set_master_weights,
+             "Keep higher-precision master copies of the parameters (mixed precision)",
+             py::arg("enabled"))
+        .def_property_readonly("master_weights", &GradientDescent<T>::master_weights,
+             "Whether master weights are enabled");
 
     // Bind Vanilla gradient descent
-    py::class_<Vanilla, GradientDescent, std::shared_ptr<Vanilla>>(m, "Vanilla")
+    py::class_<Vanilla<T>, GradientDescent<T>, std::shared_ptr<Vanilla<T>>>(m, "Vanilla")
         .def(py::init<>())
-        .def("train", &Vanilla::train, "Train the model using vanilla gradient descent",
-             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"));
-}
\ No newline at end of file
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const typename Vanilla<T>::Matrix&,
+                               const std::vector<T>&, LossFunction<T>&, const T&>(&Vanilla<T>::train),
+             "Train the model using vanilla gradient descent",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const CsrMatrix<T>&,
+                               const std::vector<T>&, LossFunction<T>&, const T&>(&Vanilla<T>::train),
+             "Train the model on a sparse CSR matrix",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, DataSource<T>&,
+                               LossFunction<T>&, const T&>(&Vanilla<T>::train),
+             "Train for one pass over a streamed data source, one step per chunk",
+             py::arg("w"), py::arg("source"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("train",
+             [](GradientDescent<T>& self, Model<T>& model, const DenseArray<T>& X, const std::vector<T>& y_true,
+                LossFunction<T>& loss_fn, const T learning_rate) {
+                 return self.train(model, as_view(X), y_true, loss_fn, learning_rate);
+             },
+             "Train a Model for one full-batch step; returns the loss before the update",
+             py::arg("model"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("train",
+             [](Vanilla<T>& self, std::vector<std::shared_ptr<Variable>>& w, const WindowedFeatures<T>& windows,
+                LossFunction<T>& loss_fn, const T learning_rate, const size_t begin, const size_t end) {
+                 const auto targets = windows.targets(begin, end);
+                 const std::vector<T> y_true(targets.begin(), targets.end());
+                 py::gil_scoped_release release;
+                 return self.train(w, windows.features(begin, end), y_true, loss_fn, learning_rate);
+             },
+             "Train on lag windows [begin, end) read in place from the series",
+             py::arg("w"), py::arg("windows"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::arg("begin") = 0, py::arg("end") = WindowedFeatures<T>::all);
+
+    // Bind online learners
+    py::class_<OnlineLearner<T>, std::shared_ptr<OnlineLearner<T>>>(m, "OnlineLearner")
+        .def_property_readonly("n_features", &OnlineLearner<T>::n_features)
+        .def_property_readonly("weights",
+             [](const OnlineLearner<T>& self) {
+                 const auto w = self.weights();
+                 py::array_t<T> result(static_cast<py::ssize_t>(w.size()));
+                 std::copy(w.begin(), w.end(), result.mutable_data());
+                 return result;
+             },
+             "Feature weights followed by the bias")
+        .def("predict",
+             [](const OnlineLearner<T>& self, const DenseArray<T>& x) {
+                 if (x.ndim() != 1 || static_cast<size_t>(x.size()) != self.n_features()) {
+                     throw std::invalid_argument("expected a 1-D array of n_features values");
+                 }
+                 return self.predict(std::span<const T>(x.data(), x.size()));
+             },
+             "Predict for one observation", py::arg("x"))
+        .def("update",
+             [](OnlineLearner<T>& self, const DenseArray<T>& x, const T y) {
+                 if (x.ndim() != 1 || static_cast<size_t>(x.size()) != self.n_features()) {
+                     throw std::invalid_argument("expected a 1-D array of n_features values");
+                 }
+                 return self.update(std::span<const T>(x.data(), x.size()), y);
+             },
+             "Learn from one observation; returns the prediction made before the update",
+             py::arg("x"), py::arg("y"))
+        .def("update",
+             [](OnlineLearner<T>& self, const DenseArray<T>& X, const DenseArray<T>& y) {
+                 const MatrixView<T> view = as_view(X);
+                 if (view.cols != self.n_features() || static_cast<size_t>(y.size()) != view.rows) {
+                     throw std::invalid_argument("expected X with n_features columns and one target per row");
+                 }
+                 py::array_t<T> predictions(static_cast<py::ssize_t>(view.rows));
+                 const std::span<T> out(predictions.mutable_data(), view.rows);
+                 {
+                     py::gil_scoped_release release;
+                     self.update(view, std::span<const T>(y.data(), view.rows), out);
+                 }
+                 return predictions;
+             },
+             "Learn from the rows of X in order; returns each row's prediction made before learning from it",
+             py::arg("X"), py::arg("y"))
+        .def("load", &OnlineLearner<T>::load, "Start from the values of the Variables w", py::arg("w"))
+        .def("store",
+             [](const OnlineLearner<T>& self, std::vector<std::shared_ptr<Variable>> w) { self.store(w); },
+             "Write the current weights into the Variables w", py::arg("w"))
+        .def("variables", &OnlineLearner<T>::variables, "The current weights as new Variables");
+
+    py::class_<OnlineSGD<T>, OnlineLearner<T>, std::shared_ptr<OnlineSGD<T>>>(m, "OnlineSGD")
+        .def(py::init<size_t, T, bool>(),
+             py::arg("n_features"), py::arg("learning_rate"), py::arg("normalized") = false)
+        .def_property("learning_rate", &OnlineSGD<T>::learning_rate, &OnlineSGD<T>::set_learning_rate);
+
+    py::class_<RecursiveLeastSquares<T>, OnlineLearner<T>, std::shared_ptr<RecursiveLeastSquares<T>>>(
+        m, "RecursiveLeastSquares")
+        .def(py::init<size_t, T, T>(),
+             py::arg("n_features"), py::arg("forgetting") = 1, py::arg("delta") = 100)
+        .def_property_readonly("forgetting", &RecursiveLeastSquares<T>::forgetting)
+        .def("reset_covariance", &RecursiveLeastSquares<T>::reset_covariance,
+             "Restart the covariance estimate, keeping the weights");
+
+    // ======== Inference Bindings ========
+    m.def("predict",
+        [](const std::vector<std::shared_ptr<Variable>>& w, const CsrMatrix<T>& X) {
+            std::vector<T> y;
+            {
+                py::gil_scoped_release release;
+                y = inference::predict(w, X);
+            }
+            return py::array_t<T>(static_cast<py::ssize_t>(y.size()), y.data());
+        },
+        "Predict with the trained linear model on a sparse matrix",
+        py::arg("w"), py::arg("X"));
+
+    m.def("predict",
+        [](const std::vector<std::shared_ptr<Variable>>& w, const DenseArray<T>& X) {
+            const MatrixView<T> view = as_view(X);
+            const std::vector<T> weights = inference::values(w);
+            py::array_t<T> y(static_cast<py::ssize_t>(view.rows));
+            const std::span<T> out(y.mutable_data(), view.rows);
+            {
+                py::gil_scoped_release release;
+                inference::predict(weights, view, out);
+            }
+            return y;
+        },
+        "Predict with the trained linear model (bias last) without building a graph",
+        py::arg("w"), py::arg("X"));
+
+    m.def("evaluate",
+        [](const std::vector<std::shared_ptr<Variable>>& w, const DenseArray<T>& X,
+           const DenseArray<T>& y_true, LossFunction<T>& loss_fn) {
+            const MatrixView<T> view = as_view(X);
+            const std::vector<T> weights = inference::values(w);
+            if (static_cast<size_t>(y_true.size()) != view.rows) {
+                throw std::invalid_argument("evaluate: X and y_true differ in row count");
+            }
+            const std::vector<T> targets(y_true.data(), y_true.data() + y_true.size());
+            py::gil_scoped_release release;
+            std::vector<T> y(view.rows);
+            inference::predict(weights, view, std::span<T>(y));
+            return loss_fn.value(y, targets);
+        },
+        "Loss of the trained linear model on (X, y) without building a graph",
+        py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"));
+
+    m.def("predict",
+        [](const std::vector<std::shared_ptr<Variable>>& w, const WindowedFeatures<T>& windows,
+           const size_t begin, const size_t end) {
+            const MatrixView<T> view = windows.features(begin, end);
+            const std::vector<T> weights = inference::values(w);
+            py::array_t<T> y(static_cast<py::ssize_t>(view.rows));
+            const std::span<T> out(y.mutable_data(), view.rows);
+            {
+                py::gil_scoped_release release;
+                inference::predict(weights, view, out);
+            }
+            return y;
+        },
+        "Predict with the trained linear model on lag windows [begin, end)",
+        py::arg("w"), py::arg("windows"), py::arg("begin") = 0, py::arg("end") = WindowedFeatures<T>::all);
+
+    m.def("evaluate",
+        [](const std::vector<std::shared_ptr<Variable>>& w, const WindowedFeatures<T>& windows,
+           LossFunction<T>& loss_fn, const size_t begin, const size_t end) {
+            const MatrixView<T> view = windows.features(begin, end);
+            const auto targets = windows.targets(begin, end);
+            const std::vector<T> weights = inference::values(w);
+            const std::vector<T> y_true(targets.begin(), targets.end());
+            py::gil_scoped_release release;
+            std::vector<T> y(view.rows);
+            inference::predict(weights, view, std::span<T>(y));
+            return loss_fn.value(y, y_true);
+        },
+        "Loss of the trained linear model on lag windows [begin, end)",
+        py::arg("w"), py::arg("windows"), py::arg("loss_fn"), py::arg("begin") = 0,
+        py::arg("end") = WindowedFeatures<T>::all);
+
+    // Bind data-parallel training (communicators are bound once, in `distributed`)
+    py::class_<distributed::DataParallel<T>>(m, "DataParallel")
+        .def(py::init<GradientDescent<T>&, distributed::Communicator&>(),
+             py::arg("optimizer"), py::arg("comm"), py::keep_alive<1, 2>(), py::keep_alive<1, 3>())
+        .def("sync_parameters",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&>(&distributed::DataParallel<T>::sync_parameters),
+             "Copy rank 0's parameter values to every rank",
+             py::arg("w"), py::call_guard<py::gil_scoped_release>())
+        .def("sync_parameters",
+             py::overload_cast<Model<T>&>(&distributed::DataParallel<T>::sync_parameters),
+             "Copy rank 0's model parameters to every rank",
+             py::arg("model"), py::call_guard<py::gil_scoped_release>())
+        .def("train",
+             py::overload_cast<std::vector<std::shared_ptr<Variable>>&, const typename GradientDescent<T>::Matrix&,
+                               const std::vector<T>&, LossFunction<T>&, const T&>(&distributed::DataParallel<T>::train),
+             "One step on this rank's shard with gradients summed over all ranks; returns the global loss",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::call_guard<py::gil_scoped_release>())
+        .def("train",
+             [](distributed::DataParallel<T>& self, Model<T>& model, const DenseArray<T>& X,
+                const std::vector<T>& y_true, LossFunction<T>& loss_fn, const T learning_rate) {
+                 const MatrixView<T> view = as_view(X);
+                 py::gil_scoped_release release;
+                 return self.train(model, view, y_true, loss_fn, learning_rate);
+             },
+             "One step of a Model on this rank's shard; returns the global loss",
+             py::arg("model"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"))
+        .def("fit", &distributed::DataParallel<T>::fit,
+             "Run several data-parallel steps and return the global loss of each",
+             py::arg("w"), py::arg("X"), py::arg("y_true"), py::arg("loss_fn"), py::arg("learning_rate"),
+             py::arg("epochs"), py::call_guard<py::gil_scoped_release>());
+
+    // Bind hyperparameter sweep
+    py::class_<typename Sweep<T>::Config>(m, "SweepConfig")
+        .def(py::init([](const T learning_rate, const size_t window_begin, const size_t window_size) {
+                return typename Sweep<T>::Config{learning_rate, window_begin, window_size};
+            }),
+            py::arg("learning_rate"), py::arg("window_begin") = 0, py::arg("window_size") = 0)
+        .def_readwrite("learning_rate", &Sweep<T>::Config::learning_rate)
+        .def_readwrite("window_begin", &Sweep<T>::Config::window_begin)
+        .def_readwrite("window_size", &Sweep<T>::Config::window_size);
+
+    py::class_<typename Sweep<T>::Result>(m, "SweepResult")
+        .def_readonly("config", &Sweep<T>::Result::config)
+        .def_readonly("loss", &Sweep<T>::Result::loss)
+        .def_readonly("epochs", &Sweep<T>::Result::epochs)
+        .def_readonly("diverged", &Sweep<T>::Result::diverged)
+        .def_readonly("weights", &Sweep<T>::Result::weights);
+
+    py::class_<Sweep<T>>(m, "Sweep")
+        .def(py::init<size_t, size_t, T>(),
+             py::arg("epochs"), py::arg("n_threads") = 0, py::arg("divergence_factor") = 10)
+        .def("run", &Sweep<T>::run, "Train one model per configuration in parallel and rank the results",
+             py::arg("X"), py::arg("y_true"), py::arg("configs"), py::arg("loss_fn"),
+             py::call_guard<py::gil_scoped_release>());
+}
+
+void bind_distributed(py::module_& m) {
+    using distributed::Communicator;
+
+    py::class_<Communicator>(m, "Communicator")
+        .def_property_readonly("rank", &Communicator::rank)
+        .def_property_readonly("size", &Communicator::size)
+        .def("allreduce",
+             [](Communicator& self, const DenseArray<double>& data) {
+                 py::array_t<double> result(std::vector<py::ssize_t>(data.shape(), data.shape() + data.ndim()));
+                 std::copy(data.data(), data.data() + data.size(), result.mutable_data());
+                 const std::span<double> values(result.mutable_data(), static_cast<size_t>(result.size()));
+                 py::gil_scoped_release release;
+                 self.allreduce(values);
+                 return result;
+             },
+             "Return the elementwise sum of `data` over all ranks", py::arg("data"))
+        .def("barrier", &Communicator::barrier, "Wait until every rank reaches the barrier",
+             py::call_guard<py::gil_scoped_release>());
+
+    py::class_<distributed::SharedMemoryCommunicator, Communicator>(m, "SharedMemoryCommunicator")
+        .def(py::init([](const std::string& name, const size_t rank, const size_t size, const size_t capacity,
+                         const double timeout) {
+                 return std::make_unique<distributed::SharedMemoryCommunicator>(
+                     name, rank, size, capacity, std::chrono::milliseconds(static_cast<long>(timeout * 1000)));
+             }),
+             "Allreduce through POSIX shared memory between processes on one machine",
+             py::arg("name"), py::arg("rank"), py::arg("size"), py::arg("capacity") = 1 << 20,
+             py::arg("timeout") = 30.0, py::call_guard<py::gil_scoped_release>());
+
+    py::class_<distributed::SocketCommunicator, Communicator>(m, "SocketCommunicator")
+        .def_static("unix_ring",
+             [](const std::string& name, const size_t rank, const size_t size, const std::string& directory,
+                const double timeout) {
+                 return distributed::SocketCommunicator::unix_ring(
+                     name, rank, size, directory, std::chrono::milliseconds(static_cast<long>(timeout * 1000)));
+             },
+             "Ring allreduce over Unix domain sockets in `directory`",
+             py::arg("name"), py::arg("rank"), py::arg("size"), py::arg("directory") = "/tmp",
+             py::arg("timeout") = 30.0, py::call_guard<py::gil_scoped_release>())
+        .def_static("tcp_ring",
+             [](const std::vector<std::string>& hosts, const size_t rank, const double timeout) {
+                 return distributed::SocketCommunicator::tcp_ring(
+                     hosts, rank, std::chrono::milliseconds(static_cast<long>(timeout * 1000)));
+             },
+             "Ring allreduce over TCP; hosts[r] is the \"host:port\" rank r listens on",
+             py::arg("hosts"), py::arg("rank"), py::arg("timeout") = 30.0,
+             py::call_guard<py::gil_scoped_release>());
+
+    m.def("shard",
+        [](const size_t n, const size_t rank, const size_t size) {
+            const distributed::Shard s = distributed::shard(n, rank, size);
+            return std::make_pair(s.begin, s.end);
+        },
+        "Rows [begin, end) of n owned by `rank` when split evenly over `size` ranks",
+        py::arg("n"), py::arg("rank"), py::arg("size"));
+}
+
+PYBIND11_MODULE(gradientdescent, m) {
+    m.doc() = "Gradient descent optimization and automatic differentiation module";
+
+    auto dist = m.def_submodule("distributed", "Multi-process data-parallel training");
+    bind_distributed(dist);
+
+    bind_precision<double>(m);
+
+    auto f32 = m.def_submodule("f32", "Single-precision (float32) engine with double accumulation");
+    bind_precision<float>(f32);
+}
@@ -1,19 +1,248 @@
 #pragma once
 #include "autodiff/variable/Variable.h"
 #include "loss/LossFunction.h"
+#include "data/sparse/CsrMatrix.h"
+#include "data/stream/DataSource.h"
+#include "checkpoint/Parameters.h"
+#include "model/Model.h"
+#include "optimizers/Validation.h"
+#include <algorithm>
 
+template <autodiff::Scalar T = double>
 class GradientDescent {
 public:
-    using Vector = std::vector<double>;
+    using Vector = std::vector<T>;
     using Matrix = std::vector<Vector>;
-    using Variable = std::shared_ptr<autodiff::Variable>;
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+    using Accum = autodiff::accumulate_t<T>;
+
+    // Per-epoch losses recorded by fit(); see Validation::History.
+    using History = typename Validation<T>::History;
 
     virtual ~GradientDescent() = default;
 
-    virtual void train(std::vector<Variable>& w,
+    // Performs one full-batch step and returns the loss before the update.
+    virtual T train(std::vector<Variable>& w,
+                    const Matrix& X,
+                    const Vector& y_true,
+                    LossFunction<T>& loss_fn,
+                    const T& learning_rate) = 0;
+
+    // Sparse step: cost scales with X.nnz(), and only parameters of columns that
+    // have a nonzero entry (plus the bias) are updated.
+    virtual T train(std::vector<Variable>& w,
+                    const CsrMatrix<T>& X,
+                    const Vector& y_true,
+                    LossFunction<T>& loss_fn,
+                    const T& learning_rate) = 0;
+
+    // Backward pass only: adds dL/dw for a full batch into the parameters'
+    // gradients and returns the loss, without updating w. Together with step()
+    // this lets callers combine gradients (e.g. across processes) before updating.
+    virtual T compute_gradients(std::vector<Variable>& w,
+                                const Matrix& X,
+                                const Vector& y_true,
+                                LossFunction<T>& loss_fn) = 0;
+
+    // Applies the accumulated gradients to w and resets them.
+    void step(std::vector<Variable>& w, const T& learning_rate) {
+        apply_gradients(w, learning_rate);
+    }
+
+    // One pass over a streamed dataset, taking a step per chunk so only the
+    // source's chunks are resident. Returns the row-weighted mean chunk loss.
+    T train(std::vector<Variable>& w,
+            DataSource<T>& source,
+            LossFunction<T>& loss_fn,
+            const T& learning_rate) {
+        Chunk<T> chunk;
+        Accum total = 0;
+        size_t rows = 0;
+
+        source.reset();
+        while (source.next(chunk)) {
+            total += static_cast<Accum>(train(w, chunk.X, chunk.y, loss_fn, learning_rate)) * chunk.rows();
+            rows += chunk.rows();
+        }
+        return rows == 0 ? T(0) : static_cast<T>(total / rows);
+    }
+
+    // One full-batch step for a Model. The loss and its gradient with respect to
+    // the model outputs (row-major, out_features per sample) come from
+    // loss_fn.gradient, and are pushed back through model.backward. Returns the
+    // loss before the update.
+    T train(Model<T>& model,
+            const MatrixView<T>& X,
+            const Vector& y_true,
+            LossFunction<T>& loss_fn,
+            const T& learning_rate) {
+        const T loss = compute_gradients(model, X, y_true, loss_fn);
+        auto params = model.parameters();
+        apply_gradients(params, learning_rate);
+        return loss;
+    }
+
+    T compute_gradients(Model<T>& model,
+                        const MatrixView<T>& X,
+                        const Vector& y_true,
+                        LossFunction<T>& loss_fn) {
+        thread_local std::vector<T> packed;
+        thread_local std::vector<T> grad_output;
+
+        const MatrixView<T> y_pred = model.forward(X);
+        const size_t n_outputs = y_pred.rows * y_pred.cols;
+        const T* outputs = y_pred.data;
+        if (y_pred.stride != y_pred.cols && y_pred.rows > 1) {
+            packed.resize(n_outputs);
+            for (size_t i = 0; i < y_pred.rows; ++i) {
+                std::copy_n(y_pred.row(i).begin(), y_pred.cols, packed.begin() + i * y_pred.cols);
+            }
+            outputs = packed.data();
+        }
+
+        grad_output.resize(n_outputs);
+        const T loss = loss_fn.gradient({outputs, n_outputs}, y_true, grad_output);
+        model.backward({grad_output.data(), y_pred.rows, y_pred.cols, y_pred.cols}, {});
+        return loss;
+    }
+
+    T train(Model<T>& model,
+            const Matrix& X,
+            const Vector& y_true,
+            LossFunction<T>& loss_fn,
+            const T& learning_rate) {
+        thread_local std::vector<T> packed;
+        const size_t cols = X.empty() ? 0 : X.front().size();
+        packed.resize(X.size() * cols);
+        for (size_t i = 0; i < X.size(); ++i) {
+            if (X[i].size() != cols) {
+                throw std::invalid_argument("train: rows of X differ in length");
+            }
+            std::copy(X[i].begin(), X[i].end(), packed.begin() + i * cols);
+        }
+        return train(model, MatrixView<T>{packed.data(), X.size(), cols, cols}, y_true, loss_fn, learning_rate);
+    }
+
+    // Runs `epochs` full passes with train(), counting epochs and handing a
+    // snapshot to the checkpointer (if any) every `checkpoint_every` epochs.
+    // With a validation set, each epoch's weights are validated on a background
+    // pool worker while the next epoch trains. Returns the loss of each epoch.
+    std::vector<T> fit(std::vector<Variable>& w,
                        const Matrix& X,
                        const Vector& y_true,
-                       LossFunction& loss_fn, 
-                       const double& learning_rate) = 0;
-                       
+                       LossFunction<T>& loss_fn,
+                       const T& learning_rate,
+                       const size_t epochs) {
+        return run_epochs(w, loss_fn, epochs, [&] { return train(w, X, y_true, loss_fn, learning_rate); });
+    }
+
+    std::vector<T> fit(std::vector<Variable>& w,
+                       DataSource<T>& source,
+                       LossFunction<T>& loss_fn,
+                       const T& learning_rate,
+                       const size_t epochs) {
+        return run_epochs(w, loss_fn, epochs, [&] { return train(w, source, loss_fn, learning_rate); });
+    }
+
+    // Validation data and early stopping for fit(); see Validation::set.
+    void set_validation(Matrix X, Vector y_true, const size_t patience = 0, const T min_delta = 0) {
+        validation_.set(std::move(X), std::move(y_true), patience, min_delta);
+    }
+
+    void clear_validation() { validation_.clear(); }
+
+    const History& history() const { return validation_.history(); }
+    void clear_history() { validation_.clear_history(); }
+
+    size_t epoch() const { return epoch_; }
+    void set_epoch(const size_t epoch) { epoch_ = epoch; }
+
+    void set_checkpointer(std::shared_ptr<checkpoint::AsyncCheckpointer<T>> checkpointer,
+                          const size_t checkpoint_every = 1) {
+        checkpointer_ = std::move(checkpointer);
+        checkpoint_every_ = checkpoint_every == 0 ? 1 : checkpoint_every;
+    }
+
+    checkpoint::Snapshot<T> snapshot(const std::vector<Variable>& w) const {
+        return checkpoint::capture(w, master_, epoch_, master_weights_);
+    }
+
+    void save_checkpoint(const std::string& path, const std::vector<Variable>& w) const {
+        checkpoint::save(path, snapshot(w));
+    }
+
+    // Restores parameters, optimizer state and epoch counter from a checkpoint.
+    // `w` is resized to the checkpoint's parameter count if needed.
+    void restore(const std::string& path, std::vector<Variable>& w) {
+        auto restored = checkpoint::restore(path, w);
+        master_weights_ = restored.master_weights;
+        master_ = std::move(restored.state);
+        epoch_ = restored.epoch;
+    }
+
+    // Mixed precision: keep an accumulate_t<T> copy of every parameter and apply
+    // updates to it, so small steps are not lost to float rounding.
+    void set_master_weights(const bool enabled) {
+        master_weights_ = enabled;
+        master_.clear();
+    }
+    bool master_weights() const { return master_weights_; }
+
+protected:
+    void apply_gradients(std::vector<Variable>& w, const T& learning_rate) {
+        for (size_t i = 0; i < w.size(); ++i) {
+            apply_gradient(w, i, learning_rate);
+        }
+    }
+
+    // Lazy update of the listed parameters only; the others must have zero gradient.
+    void apply_gradients(std::vector<Variable>& w, const std::vector<size_t>& indices,
+                         const T& learning_rate) {
+        for (const size_t i : indices) {
+            apply_gradient(w, i, learning_rate);
+        }
+    }
+
+private:
+    bool master_weights_ = false;
+    std::vector<Accum> master_;
+    size_t epoch_ = 0;
+    std::shared_ptr<checkpoint::AsyncCheckpointer<T>> checkpointer_;
+    size_t checkpoint_every_ = 1;
+
+    Validation<T> validation_;
+
+    // One fit(): counts epochs and hands a snapshot to the checkpointer (if
+    // any) every checkpoint_every_ epochs.
+    template <typename Step>
+    std::vector<T> run_epochs(std::vector<Variable>& w, LossFunction<T>& loss_fn, const size_t epochs, Step&& step) {
+        return validation_.run(w, loss_fn, epochs, [&] {
+            const T loss = step();
+            ++epoch_;
+            if (checkpointer_ && epoch_ % checkpoint_every_ == 0) {
+                checkpointer_->submit(snapshot(w));
+            }
+            return loss;
+        });
+    }
+
+    void apply_gradient(std::vector<Variable>& w, const size_t i, const T& learning_rate) {
+        const auto& param = w[i];
+        if (!master_weights_) {
+            param->set_value(static_cast<T>(param->value() - learning_rate * param->grad()));
+            param->zero_grad();
+            return;
+        }
+
+        if (master_.size() != w.size()) {
+            master_.resize(w.size());
+        }
+        // Resynchronise when the parameter was changed outside the optimizer.
+        if (static_cast<T>(master_[i]) != param->value()) {
+            master_[i] = param->value();
+        }
+        master_[i] -= learning_rate * param->grad();
+        param->set_value(static_cast<T>(master_[i]));
+        param->zero_grad();
+    }
 };
@@ -0,0 +1,120 @@
+#pragma once
+#include <limits>
+#include <span>
+#include <vector>
+#include "autodiff/variable/Variable.h"
+#include "inference/Inference.h"
+#include "loss/LossFunction.h"
+#include "parallel/ParallelFor.h"
+
+// Validation set, loss history and early stopping for GradientDescent::fit.
+// run() validates each epoch's weights on a background pool worker while the
+// next epoch trains, so validation only adds to the wall time of the last epoch.
+template <autodiff::Scalar T = double>
+class Validation {
+public:
+    using Vector = std::vector<T>;
+    using Matrix = std::vector<Vector>;
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+
+    // Per-epoch losses recorded by run(). loss[e] is the training loss before the
+    // update of epoch e; validation_loss[e] is measured on the weights after it.
+    // best_epoch is the 0-based index into validation_loss of the best weights
+    // (the last epoch that improved on the previous best by more than min_delta).
+    struct History {
+        std::vector<T> loss;
+        std::vector<T> validation_loss;
+        size_t best_epoch = 0;
+        bool stopped_early = false;
+    };
+
+    // With patience > 0, run() stops once the validation loss has not improved
+    // by more than min_delta for `patience` epochs. The best weights are
+    // restored only when training stops early this way; a run that uses all its
+    // epochs keeps the final weights.
+    void set(Matrix X, Vector y_true, const size_t patience = 0, const T min_delta = 0) {
+        X_ = std::move(X);
+        y_ = std::move(y_true);
+        patience_ = patience;
+        min_delta_ = min_delta;
+    }
+
+    void clear() {
+        X_.clear();
+        y_.clear();
+    }
+
+    bool enabled() const { return !y_.empty(); }
+
+    const History& history() const { return history_; }
+    void clear_history() { history_ = History{}; }
+
+    // Calls epoch() up to `epochs` times; each call trains one epoch of w and
+    // returns its loss. Returns the loss of each epoch that ran.
+    template <typename Epoch>
+    std::vector<T> run(std::vector<Variable>& w, LossFunction<T>& loss_fn, const size_t epochs, Epoch&& epoch) {
+        const bool validate = enabled();
+        // in_flight is declared first so it outlives a validation still running
+        // if epoch() throws.
+        std::vector<T> in_flight;
+        parallel::Pending<T> pending;
+        std::vector<T> best_weights;
+        bool stopped = false;
+        T best_loss = std::numeric_limits<T>::infinity();
+        size_t since_best = 0;
+
+        // Records the result of the in-flight validation; returns true to stop.
+        const auto collect = [&] {
+            if (!pending.valid()) return false;
+            const T loss = pending.get();
+            history_.validation_loss.push_back(loss);
+            if (loss < best_loss - min_delta_) {
+                best_loss = loss;
+                best_weights.swap(in_flight);
+                history_.best_epoch = history_.validation_loss.size() - 1;
+                since_best = 0;
+                return false;
+            }
+            return patience_ > 0 && ++since_best >= patience_;
+        };
+
+        std::vector<T> losses;
+        losses.reserve(epochs);
+        for (size_t e = 0; e < epochs; ++e) {
+            losses.push_back(epoch());
+            history_.loss.push_back(losses.back());
+
+            if (validate) {
+                if (collect()) {
+                    stopped = true;
+                    break;
+                }
+                in_flight = inference::values(w);
+                pending = parallel::Pending<T>([this, &in_flight, &loss_fn] { return loss(in_flight, loss_fn); });
+            }
+        }
+
+        stopped = stopped || (validate && collect());
+        history_.stopped_early = stopped;
+        if (stopped && best_weights.size() == w.size()) {
+            for (size_t i = 0; i < w.size(); ++i) {
+                w[i]->set_value(best_weights[i]);
+            }
+        }
+        return losses;
+    }
+
+private:
+    Matrix X_;
+    Vector y_;
+    size_t patience_ = 0;
+    T min_delta_ = 0;
+    History history_;
+
+    T loss(const std::vector<T>& weights, LossFunction<T>& loss_fn) const {
+        std::vector<T> y_pred(y_.size());
+        inference::predict_rows(weights, y_.size(), [this](const size_t i) { return std::span<const T>(X_[i]); },
+                                std::span<T>(y_pred));
+        return loss_fn.value(y_pred, y_);
+    }
+};
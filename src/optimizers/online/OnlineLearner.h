@@ -0,0 +1,111 @@
+#pragma once
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "autodiff/variable/Variable.h"
+#include "data/MatrixView.h"
+
+// Linear model updated one observation at a time, for streams where retraining
+// on the whole history per sample is too slow. Weights follow the optimizers'
+// layout (features, then the bias) and are kept in accumulate_t<T>.
+//
+// update() and predict() do not allocate or lock, so they can run on a
+// latency-sensitive thread. They throw std::invalid_argument when the shapes do
+// not match n_features(), before anything is learned; past the checks, the
+// work is done by noexcept kernels. A learner is not synchronised: call it
+// from one thread at a time.
+template <autodiff::Scalar T = double>
+class OnlineLearner {
+public:
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+    using Accum = autodiff::accumulate_t<T>;
+
+    virtual ~OnlineLearner() = default;
+
+    size_t n_features() const { return weights_.size() - 1; }
+
+    // Feature weights followed by the bias.
+    std::span<const Accum> weights() const { return weights_; }
+
+    T predict(const std::span<const T> x) const {
+        check_features(x.size());
+        return predict_unchecked(x);
+    }
+
+    // Learns from (x, y) and returns the prediction made before the update.
+    T update(const std::span<const T> x, const T y) {
+        check_features(x.size());
+        return update_unchecked(x, y);
+    }
+
+    // Feeds the rows of X in order; predictions[i] (if given) receives the
+    // prediction for row i made before learning from it.
+    void update(const MatrixView<T>& X, const std::span<const T> y, const std::span<T> predictions = {}) {
+        check_features(X.cols);
+        if (y.size() != X.rows) {
+            throw std::invalid_argument("OnlineLearner: expected one target per row of X");
+        }
+        if (!predictions.empty() && predictions.size() != X.rows) {
+            throw std::invalid_argument("OnlineLearner: expected one prediction slot per row of X");
+        }
+        for (size_t i = 0; i < X.rows; ++i) {
+            const T prediction = update_unchecked(X.row(i), y[i]);
+            if (!predictions.empty()) predictions[i] = prediction;
+        }
+    }
+
+    // Starts from the values of w, e.g. a model trained in batch by Vanilla.
+    void load(const std::vector<Variable>& w) {
+        if (w.size() != weights_.size()) {
+            throw std::invalid_argument("OnlineLearner: expected n_features + 1 parameters");
+        }
+        for (size_t j = 0; j < w.size(); ++j) {
+            weights_[j] = w[j]->value();
+        }
+    }
+
+    // Writes the current weights into w, so inference and checkpoints can use them.
+    void store(std::vector<Variable>& w) const {
+        if (w.size() != weights_.size()) {
+            throw std::invalid_argument("OnlineLearner: expected n_features + 1 parameters");
+        }
+        for (size_t j = 0; j < w.size(); ++j) {
+            w[j]->set_value(static_cast<T>(weights_[j]));
+        }
+    }
+
+    std::vector<Variable> variables() const {
+        std::vector<Variable> w;
+        w.reserve(weights_.size());
+        for (const Accum value : weights_) {
+            w.push_back(autodiff::BasicVariable<T>::create(static_cast<T>(value), true));
+        }
+        return w;
+    }
+
+protected:
+    std::vector<Accum> weights_;
+
+    explicit OnlineLearner(const size_t n_features) : weights_(n_features + 1, Accum(0)) {}
+
+    // x holds n_features() values.
+    T predict_unchecked(const std::span<const T> x) const noexcept {
+        Accum total = weights_.back();
+        for (size_t j = 0; j < x.size(); ++j) {
+            total += static_cast<Accum>(x[j]) * weights_[j];
+        }
+        return static_cast<T>(total);
+    }
+
+private:
+    // The learner's step; x holds n_features() values.
+    virtual T update_unchecked(std::span<const T> x, T y) noexcept = 0;
+
+    void check_features(const size_t n) const {
+        if (n != n_features()) {
+            throw std::invalid_argument("OnlineLearner: expected " + std::to_string(n_features()) +
+                                        " features, got " + std::to_string(n));
+        }
+    }
+};
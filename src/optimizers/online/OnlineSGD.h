@@ -0,0 +1,46 @@
+#pragma once
+#include "optimizers/online/OnlineLearner.h"
+
+// Least-mean-squares: one gradient step on (y - w.x)^2 / 2 per observation,
+// O(n_features) per update. With `normalized`, the step is divided by
+// 1 + |x|^2 (NLMS), which keeps it stable whatever the scale of the features.
+// A constant learning rate already discounts old observations geometrically.
+template <autodiff::Scalar T = double>
+class OnlineSGD final : public OnlineLearner<T> {
+public:
+    using Accum = autodiff::accumulate_t<T>;
+
+    OnlineSGD(const size_t n_features, const T learning_rate, const bool normalized = false)
+        : OnlineLearner<T>(n_features), learning_rate_(learning_rate), normalized_(normalized) {
+        if (!(learning_rate > 0)) {
+            throw std::invalid_argument("OnlineSGD: learning rate must be positive");
+        }
+    }
+
+    T learning_rate() const { return learning_rate_; }
+    void set_learning_rate(const T learning_rate) noexcept { learning_rate_ = learning_rate; }
+
+private:
+    T learning_rate_;
+    bool normalized_;
+
+    T update_unchecked(const std::span<const T> x, const T y) noexcept override {
+        auto& w = this->weights_;
+        const T prediction = this->predict_unchecked(x);
+
+        Accum step = learning_rate_;
+        if (normalized_) {
+            Accum norm = 1; // The bias input
+            for (const T value : x) {
+                norm += static_cast<Accum>(value) * value;
+            }
+            step /= norm;
+        }
+        const Accum scaled_error = step * (static_cast<Accum>(y) - prediction);
+        for (size_t j = 0; j < x.size(); ++j) {
+            w[j] += scaled_error * x[j];
+        }
+        w.back() += scaled_error;
+        return prediction;
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <algorithm>
+#include "optimizers/online/OnlineLearner.h"
+
+// Recursive least squares: after each update the weights minimise
+// sum_t lambda^(n - t) (y_t - w.x_t)^2 over everything seen so far, at
+// O(n_features^2) per update. The forgetting factor lambda in (0, 1] weights
+// older observations down (1 keeps them all; 0.99 remembers about 100 steps).
+// P, the inverse of the weighted input covariance, starts as delta * I; a larger
+// delta trusts the initial weights less.
+template <autodiff::Scalar T = double>
+class RecursiveLeastSquares final : public OnlineLearner<T> {
+public:
+    using Accum = autodiff::accumulate_t<T>;
+
+    explicit RecursiveLeastSquares(const size_t n_features, const T forgetting = 1, const T delta = 100)
+        : OnlineLearner<T>(n_features), forgetting_(forgetting), delta_(delta),
+          p_((n_features + 1) * (n_features + 1)), px_(n_features + 1), input_(n_features + 1) {
+        if (!(forgetting > 0 && forgetting <= 1)) {
+            throw std::invalid_argument("RecursiveLeastSquares: forgetting factor must be in (0, 1]");
+        }
+        if (!(delta > 0)) {
+            throw std::invalid_argument("RecursiveLeastSquares: delta must be positive");
+        }
+        reset_covariance();
+    }
+
+    T forgetting() const { return forgetting_; }
+
+    // Restarts P at delta * I and keeps the weights, e.g. after a regime change.
+    void reset_covariance() noexcept {
+        const size_t d = input_.size();
+        std::fill(p_.begin(), p_.end(), Accum(0));
+        for (size_t i = 0; i < d; ++i) {
+            p_[i * d + i] = delta_;
+        }
+    }
+
+private:
+    T forgetting_;
+    T delta_;
+    std::vector<Accum> p_;     // d x d, row-major, d = n_features + 1
+    std::vector<Accum> px_;    // Scratch for P x
+    std::vector<Accum> input_; // x with the bias input appended
+
+    T update_unchecked(const std::span<const T> x, const T y) noexcept override {
+        auto& w = this->weights_;
+        const size_t d = input_.size();
+        std::copy(x.begin(), x.end(), input_.begin());
+        input_.back() = 1;
+        const T prediction = this->predict_unchecked(x);
+
+        // px = P x, denominator = lambda + x' P x
+        Accum denominator = forgetting_;
+        for (size_t i = 0; i < d; ++i) {
+            const Accum* row = p_.data() + i * d;
+            Accum total = 0;
+            for (size_t j = 0; j < d; ++j) {
+                total += row[j] * input_[j];
+            }
+            px_[i] = total;
+            denominator += input_[i] * total;
+        }
+
+        // w += P x e / denominator; P = (P - P x x' P / denominator) / lambda.
+        // P is updated on the upper triangle and mirrored, so it stays symmetric.
+        const Accum error = static_cast<Accum>(y) - prediction;
+        const Accum inverse = 1 / denominator;
+        const Accum inverse_forgetting = 1 / static_cast<Accum>(forgetting_);
+        for (size_t i = 0; i < d; ++i) {
+            const Accum gain = px_[i] * inverse;
+            w[i] += gain * error;
+            for (size_t j = i; j < d; ++j) {
+                const Accum value = (p_[i * d + j] - gain * px_[j]) * inverse_forgetting;
+                p_[i * d + j] = value;
+                p_[j * d + i] = value;
+            }
+        }
+        return prediction;
+    }
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include "autodiff/variable/Variable.h"
+#include "loss/LossFunction.h"
+#include "optimizers/vanilla/Vanilla.h"
+#include "parallel/ParallelFor.h"
+
+// Trains independent linear models for a grid of hyperparameters on one shared,
+// read-only dataset. Each configuration owns its weights and optimizer, and runs
+// on a worker thread; the loss function is shared and must be stateless.
+template <autodiff::Scalar T = double>
+class Sweep {
+public:
+    using Vector = std::vector<T>;
+    using Matrix = std::vector<Vector>;
+
+    struct Config {
+        T learning_rate;
+        size_t window_begin = 0; // First feature column used by the model
+        size_t window_size = 0;  // Number of feature columns; 0 means all remaining
+    };
+
+    struct Result {
+        Config config;
+        T loss;
+        size_t epochs;
+        bool diverged;
+        std::vector<T> weights; // Feature weights followed by the bias
+    };
+
+    explicit Sweep(const size_t epochs, const size_t n_threads = 0, const T divergence_factor = 10)
+        : epochs(epochs), n_threads(n_threads), divergence_factor(divergence_factor) {}
+
+    // Returns one result per configuration, best first. Diverged runs are ranked
+    // last, those that lasted longest first, since their losses may be NaN.
+    std::vector<Result> run(const Matrix& X,
+                            const Vector& y_true,
+                            const std::vector<Config>& configs,
+                            LossFunction<T>& loss_fn) const {
+        const size_t n_columns = X.empty() ? 0 : X.front().size();
+        check(X, y_true, configs, n_columns);
+        std::vector<Result> results(configs.size());
+
+        parallel::parallel_for(0, configs.size(), 1, [&](const size_t lo, const size_t hi) {
+            for (size_t c = lo; c < hi; ++c) {
+                results[c] = fit(X, y_true, configs[c], n_columns, loss_fn);
+            }
+        }, n_threads);
+
+        std::stable_sort(results.begin(), results.end(), [](const Result& a, const Result& b) {
+            if (a.diverged != b.diverged) return !a.diverged;
+            if (a.diverged) return a.epochs > b.epochs;
+            return a.loss < b.loss;
+        });
+        return results;
+    }
+
+private:
+    size_t epochs;
+    size_t n_threads;
+    T divergence_factor;
+
+    static void check(const Matrix& X, const Vector& y_true, const std::vector<Config>& configs,
+                      const size_t n_columns) {
+        if (X.size() != y_true.size()) {
+            throw std::invalid_argument("Sweep: X and y_true differ in row count");
+        }
+        for (const auto& row : X) {
+            if (row.size() != n_columns) {
+                throw std::invalid_argument("Sweep: rows of X differ in length");
+            }
+        }
+        for (const auto& config : configs) {
+            if (config.window_begin >= n_columns) {
+                throw std::invalid_argument("Sweep: window_begin is past the last feature column");
+            }
+        }
+    }
+
+    Result fit(const Matrix& X, const Vector& y_true, const Config& config,
+               const size_t n_columns, LossFunction<T>& loss_fn) const {
+        const size_t begin = config.window_begin;
+        const size_t size = config.window_size == 0
+            ? n_columns - begin
+            : std::min(config.window_size, n_columns - begin);
+
+        std::vector<std::shared_ptr<autodiff::BasicVariable<T>>> w;
+        w.reserve(size + 1);
+        for (size_t j = 0; j <= size; ++j) {
+            w.push_back(autodiff::BasicVariable<T>::create(0.0, true));
+        }
+
+        const auto window = [&X, begin, size](const size_t i) {
+            return std::span<const T>(X[i]).subspan(begin, size);
+        };
+
+        Vanilla<T> optimizer;
+        Result result{config, 0, 0, false, {}};
+        T initial_loss = 0;
+
+        for (size_t epoch = 0; epoch < epochs; ++epoch) {
+            result.loss = optimizer.train_rows(w, window, y_true, loss_fn, config.learning_rate);
+            result.epochs = epoch + 1;
+
+            if (epoch == 0) initial_loss = result.loss;
+            if (!std::isfinite(result.loss) || result.loss > divergence_factor * initial_loss) {
+                result.diverged = true;
+                break;
+            }
+        }
+
+        result.weights.reserve(w.size());
+        for (const auto& param : w) {
+            result.weights.push_back(param->value());
+        }
+        return result;
+    }
+};
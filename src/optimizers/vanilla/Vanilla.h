@@ -1,19 +1,126 @@
 #pragma once
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include "autodiff/variable/Variable.h"
 #include "optimizers/GradientDescent.h"
 
-class Vanilla final : public GradientDescent {
-    std::vector<std::shared_ptr<autodiff::Variable>> y_pred;
+template <autodiff::Scalar T = double>
+class Vanilla final : public GradientDescent<T> {
 public:
-    using Vector = std::vector<double>;
+    using Vector = std::vector<T>;
     using Matrix = std::vector<Vector>;
-    using Variable = std::shared_ptr<autodiff::Variable>;
+    using Variable = std::shared_ptr<autodiff::BasicVariable<T>>;
+    using GradientDescent<T>::train;
+    using GradientDescent<T>::compute_gradients;
 
-    void train(std::vector<Variable>& w,
+    T train(std::vector<Variable>& w,
            const Matrix& X,
            const Vector& y_true,
-           LossFunction& loss_fn, 
-           const double& learning_rate) override {
+           LossFunction<T>& loss_fn,
+           const T& learning_rate) override {
+        check_rows(w, X, y_true);
+        return train_rows(w, [&X](const size_t i) { return std::span<const T>(X[i]); },
+                          y_true, loss_fn, learning_rate);
+    }
+
+    // Rows read in place from a view, e.g. a NumPy buffer or lag windows over a
+    // series, without building a Matrix.
+    T train(std::vector<Variable>& w,
+            const MatrixView<T>& X,
+            const Vector& y_true,
+            LossFunction<T>& loss_fn,
+            const T& learning_rate) {
+        check_shape(w, X.rows, X.cols, y_true);
+        return train_rows(w, [&X](const size_t i) { return X.row(i); }, y_true, loss_fn, learning_rate);
+    }
+
+    T compute_gradients(std::vector<Variable>& w,
+                        const Matrix& X,
+                        const Vector& y_true,
+                        LossFunction<T>& loss_fn) override {
+        check_rows(w, X, y_true);
+        return compute_gradients_rows(w, [&X](const size_t i) { return std::span<const T>(X[i]); },
+                                      y_true, loss_fn);
+    }
+
+    T train(std::vector<Variable>& w,
+           const CsrMatrix<T>& X,
+           const Vector& y_true,
+           LossFunction<T>& loss_fn,
+           const T& learning_rate) override {
+        thread_local std::vector<Variable> y_pred;
+        thread_local std::vector<Variable> terms;
+        thread_local std::vector<size_t> touched;
+        thread_local std::vector<char> seen;
+
+        check_shape(w, X.rows(), X.cols(), y_true);
+        if (X.cols() != w.size() - 1) {
+            throw std::invalid_argument("train: sparse X must have exactly one column per feature weight");
+        }
+        const size_t n_samples = y_true.size();
+        const size_t n_features = w.size() - 1; // Last element is bias
+        y_pred.clear();
+        y_pred.reserve(n_samples);
+        touched.clear();
+        if (seen.size() < n_features) seen.resize(n_features, 0);
+
+        // Only nonzero entries become graph nodes.
+        for (size_t i = 0; i < n_samples; ++i) {
+            const auto row = X.row(i);
+            terms.clear();
+            terms.push_back(w[n_features]);
+
+            for (size_t k = 0; k < row.nnz(); ++k) {
+                const size_t j = row.indices[k];
+                terms.push_back(w[j] * row.values[k]);
+                if (!seen[j]) {
+                    seen[j] = 1;
+                    touched.push_back(j);
+                }
+            }
+
+            y_pred.push_back(autodiff::sum(terms));
+        }
+
+        // Cleared before the loss runs: a loss that throws must not leave
+        // columns marked on this thread, or later steps would skip them.
+        for (const size_t j : touched) {
+            seen[j] = 0;
+        }
+
+        const auto loss = loss_fn.compute(y_pred, y_true);
+        loss->backward();
+        y_pred.clear();
+        terms.clear();
+
+        touched.push_back(n_features);
+        this->apply_gradients(w, touched, learning_rate);
+        return loss->value();
+    }
+
+    // Same step as train(), but row i is produced by row_at(i); a row only needs
+    // operator[] for the first w.size() - 1 features. Lets callers train on views
+    // (column windows, strided data) without copying the dataset.
+    template <typename RowAt>
+    T train_rows(std::vector<Variable>& w,
+                 RowAt&& row_at,
+                 const Vector& y_true,
+                 LossFunction<T>& loss_fn,
+                 const T& learning_rate) {
+        const T loss = compute_gradients_rows(w, std::forward<RowAt>(row_at), y_true, loss_fn);
+        this->apply_gradients(w, learning_rate);
+        return loss;
+    }
+
+    template <typename RowAt>
+    T compute_gradients_rows(std::vector<Variable>& w,
+                             RowAt&& row_at,
+                             const Vector& y_true,
+                             LossFunction<T>& loss_fn) {
+        // Graph scratch is per thread, so independent models can train concurrently.
+        thread_local std::vector<Variable> y_pred;
+        thread_local std::vector<Variable> terms;
 
         const size_t n_samples = y_true.size();
         y_pred.clear();
@@ -22,23 +129,45 @@ public:
         y_pred.reserve(n_samples);
 
         for (size_t i = 0; i < n_samples; ++i) {
-            auto pred = w[n_features];
-            
+            const auto row = row_at(i);
+            terms.clear();
+            terms.push_back(w[n_features]);
+
             for (size_t j = 0; j < n_features; ++j) {
-                auto x_ij = autodiff::Variable::create(X[i][j]);
-                pred = pred + w[j] * x_ij;
+                terms.push_back(w[j] * row[j]);
             }
 
-            y_pred.push_back(pred);
+            y_pred.push_back(autodiff::sum(terms));
         }
 
         const auto loss = loss_fn.compute(y_pred, y_true);
         loss->backward();
+        y_pred.clear();
+        terms.clear();
+        return loss->value();
+    }
 
-        for (const auto& param : w) {
-            param->set_value(param->value() - learning_rate * param->grad());
-            param->zero_grad();
+private:
+    // X has one row per target and at least w.size() - 1 (the bias) features.
+    static void check_shape(const std::vector<Variable>& w, const size_t rows, const size_t cols,
+                            const Vector& y_true) {
+        if (w.empty()) {
+            throw std::invalid_argument("train: weights must include the bias");
+        }
+        if (rows != y_true.size()) {
+            throw std::invalid_argument("train: X and y_true differ in row count");
+        }
+        if (cols < w.size() - 1) {
+            throw std::invalid_argument("train: X has fewer columns than the model has features");
         }
     }
 
+    static void check_rows(const std::vector<Variable>& w, const Matrix& X, const Vector& y_true) {
+        check_shape(w, X.size(), w.empty() ? 0 : w.size() - 1, y_true);
+        for (const auto& row : X) {
+            if (row.size() < w.size() - 1) {
+                throw std::invalid_argument("train: a row of X has fewer values than the model has features");
+            }
+        }
+    }
 };
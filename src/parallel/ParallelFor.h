@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+
+    inline size_t default_threads() {
+        const size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    // Persistent worker threads shared by every parallel_for. Workers are started
+    // on first use and the pool grows to the largest thread count requested, so
+    // repeated calls (one per matmul or epoch) pay no thread creation.
+    class ThreadPool {
+    public:
+        static ThreadPool& instance() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        ~ThreadPool() {
+            {
+                std::lock_guard lock(mutex_);
+                stopping_ = true;
+            }
+            ready_.notify_all();
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // Queues `copies` runs of task, starting workers until there are at least
+        // `copies` of them.
+        void submit(const std::function<void()>& task, const size_t copies) {
+            {
+                std::lock_guard lock(mutex_);
+                while (workers_.size() < copies) {
+                    workers_.emplace_back([this] { run(); });
+                }
+                for (size_t c = 0; c < copies; ++c) {
+                    tasks_.push_back(task);
+                }
+            }
+            if (copies == 1) {
+                ready_.notify_one();
+            } else {
+                ready_.notify_all();
+            }
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<std::function<void()>> tasks_;
+        std::vector<std::thread> workers_;
+        bool stopping_ = false;
+
+        ThreadPool() = default;
+
+        void run() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock lock(mutex_);
+                    ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                    if (tasks_.empty()) return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+    };
+
+    // Result of a task queued on the pool. get() runs the task on the calling
+    // thread if no worker has started it yet, so waiting never depends on a free
+    // worker. Destroying a Pending waits for a task that is already running.
+    template <typename R>
+    class Pending {
+    public:
+        Pending() = default;
+
+        template <typename F>
+        explicit Pending(F&& task) : state_(std::make_shared<State>(std::forward<F>(task))) {
+            result_ = state_->task.get_future();
+            ThreadPool::instance().submit([state = state_] { state->run(); }, 1);
+        }
+
+        Pending(Pending&&) noexcept = default;
+        Pending& operator=(Pending&& other) noexcept {
+            if (this != &other) {
+                finish();
+                state_ = std::move(other.state_);
+                result_ = std::move(other.result_);
+            }
+            return *this;
+        }
+
+        ~Pending() { finish(); }
+
+        bool valid() const { return result_.valid(); }
+
+        R get() {
+            state_->run();
+            state_.reset();
+            return result_.get();
+        }
+
+    private:
+        struct State {
+            std::atomic<bool> claimed{false};
+            std::packaged_task<R()> task;
+
+            template <typename F>
+            explicit State(F&& f) : task(std::forward<F>(f)) {}
+
+            void run() {
+                if (!claimed.exchange(true)) task();
+            }
+        };
+
+        std::shared_ptr<State> state_;
+        std::future<R> result_;
+
+        void finish() {
+            if (!state_) return;
+            if (state_->claimed.exchange(true)) {
+                result_.wait();
+            }
+            state_.reset();
+            result_ = {};
+        }
+    };
+
+    // Runs body(lo, hi) over [begin, end) in blocks of `grain` indices. Blocks are
+    // handed out dynamically, so uneven work balances across threads. The first
+    // exception thrown by a block is rethrown on the calling thread.
+    //
+    // The calling thread works on its own blocks and only waits for blocks that
+    // a pool worker has already started, so nested or concurrent calls cannot
+    // deadlock when every worker is busy.
+    template <typename Body>
+    void parallel_for(const size_t begin, const size_t end, const size_t grain, Body&& body,
+                      size_t n_threads = 0) {
+        if (begin >= end) return;
+
+        const size_t step = std::max<size_t>(grain, 1);
+        const size_t n_blocks = (end - begin + step - 1) / step;
+        if (n_threads == 0) n_threads = default_threads();
+        n_threads = std::min(n_threads, n_blocks);
+
+        if (n_threads <= 1) {
+            body(begin, end);
+            return;
+        }
+
+        // Shared with the queued helpers, which may start after this call has
+        // returned; they then find no blocks left and never touch `body`.
+        struct Job {
+            std::atomic<size_t> next{0};
+            std::atomic<bool> failed{false};
+            size_t done = 0;
+            std::exception_ptr error;
+            std::mutex mutex;
+            std::condition_variable finished;
+        };
+        const auto job = std::make_shared<Job>();
+        const std::function<void(size_t, size_t)> run_block = [&body](const size_t lo, const size_t hi) { body(lo, hi); };
+
+        const auto work = [job, n_blocks, begin, end, step, run = &run_block] {
+            size_t completed = 0;
+            for (size_t block = job->next++; block < n_blocks; block = job->next++) {
+                if (!job->failed) {
+                    const size_t lo = begin + block * step;
+                    try {
+                        (*run)(lo, std::min(end, lo + step));
+                    } catch (...) {
+                        std::lock_guard lock(job->mutex);
+                        if (!job->error) job->error = std::current_exception();
+                        job->failed = true;
+                    }
+                }
+                ++completed;
+            }
+            if (completed == 0) return;
+            std::lock_guard lock(job->mutex);
+            job->done += completed;
+            if (job->done == n_blocks) job->finished.notify_all();
+        };
+
+        ThreadPool::instance().submit(work, n_threads - 1);
+        work();
+
+        std::unique_lock lock(job->mutex);
+        job->finished.wait(lock, [&] { return job->done == n_blocks; });
+        if (job->error) std::rethrow_exception(job->error);
+    }
+
+}
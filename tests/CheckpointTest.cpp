@@ -0,0 +1,186 @@
+// Checkpoint format: save() followed by MappedCheckpoint gives back the
+// parameters, optimizer state, epoch and master-weights flag; AsyncCheckpointer
+// leaves the latest snapshot on disk after flush(); and truncated files,
+// foreign files, the wrong scalar type and headers whose counts do not fit the
+// file are rejected instead of being read out of bounds.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+#include "checkpoint/Checkpoint.h"
+
+namespace {
+
+    int failures = 0;
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    std::string temp_dir() {
+        char name[] = "/tmp/gd_checkpoint_XXXXXX";
+        if (!::mkdtemp(name)) throw std::runtime_error("mkdtemp failed");
+        return name;
+    }
+
+    std::vector<char> read_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    void write_file(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    template <autodiff::Scalar T>
+    checkpoint::Snapshot<T> make_snapshot(const size_t n_params, const std::uint64_t epoch, const bool master) {
+        checkpoint::Snapshot<T> snapshot;
+        for (size_t i = 0; i < n_params; ++i) {
+            snapshot.params.push_back(static_cast<T>(0.25 * i - 1));
+        }
+        // Optimizer state is typically larger than the parameters (e.g. moments).
+        for (size_t i = 0; i < 2 * n_params + 1; ++i) {
+            snapshot.state.push_back(static_cast<autodiff::accumulate_t<T>>(1e-3 * i + epoch));
+        }
+        snapshot.epoch = epoch;
+        snapshot.master_weights = master;
+        return snapshot;
+    }
+
+    template <autodiff::Scalar T>
+    bool matches(const checkpoint::MappedCheckpoint<T>& mapped, const checkpoint::Snapshot<T>& snapshot) {
+        const auto params = mapped.params();
+        const auto state = mapped.state();
+        const bool master = (mapped.header().flags & checkpoint::master_weights_flag) != 0;
+        return params.size() == snapshot.params.size() && state.size() == snapshot.state.size() &&
+               std::equal(params.begin(), params.end(), snapshot.params.begin()) &&
+               std::equal(state.begin(), state.end(), snapshot.state.begin()) &&
+               mapped.header().epoch == snapshot.epoch && master == snapshot.master_weights;
+    }
+
+    template <autodiff::Scalar T>
+    void check_round_trip(const std::string& dir, const std::string& type) {
+        // Odd parameter counts leave the state behind padding.
+        for (const size_t n_params : {0, 1, 3, 8}) {
+            for (const bool master : {false, true}) {
+                const auto snapshot = make_snapshot<T>(n_params, 7 + n_params, master);
+                const std::string path = dir + "/round_trip_" + type;
+                checkpoint::save(path, snapshot);
+                const checkpoint::MappedCheckpoint<T> mapped(path);
+                check(type + ": round trip of " + std::to_string(n_params) + " params" +
+                      (master ? ", master weights" : ""), matches(mapped, snapshot));
+            }
+        }
+    }
+
+    template <typename Exception>
+    bool throws(const std::function<void()>& call) {
+        try {
+            call();
+        } catch (const Exception&) {
+            return true;
+        }
+        return false;
+    }
+
+    // Rewrites the header of a valid file and checks that mapping it fails.
+    void check_corrupt_header(const std::string& path, const std::string& what,
+                              const std::function<void(checkpoint::CheckpointHeader&)>& corrupt) {
+        checkpoint::save(path, make_snapshot<double>(5, 1, false));
+        auto bytes = read_file(path);
+        checkpoint::CheckpointHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        corrupt(header);
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        write_file(path, bytes);
+        check("rejects " + what,
+              throws<std::runtime_error>([&] { checkpoint::MappedCheckpoint<double> mapped(path); }));
+    }
+
+    void check_rejections(const std::string& dir) {
+        const std::string path = dir + "/corrupt";
+
+        checkpoint::save(path, make_snapshot<double>(5, 1, false));
+        const auto valid = read_file(path);
+        for (const size_t keep : {size_t{0}, sizeof(checkpoint::CheckpointHeader) - 1,
+                                  sizeof(checkpoint::CheckpointHeader) + 8, valid.size() - 1}) {
+            write_file(path, std::vector<char>(valid.begin(), valid.begin() + keep));
+            check("rejects a file truncated to " + std::to_string(keep) + " of " + std::to_string(valid.size()) +
+                  " bytes", throws<std::runtime_error>([&] { checkpoint::MappedCheckpoint<double> mapped(path); }));
+        }
+
+        check_corrupt_header(path, "a wrong magic", [](auto& header) { header.magic[0] = 'X'; });
+        check_corrupt_header(path, "an unknown version", [](auto& header) { header.version = 2; });
+        check_corrupt_header(path, "n_params past the end of the file", [](auto& header) { header.n_params = 64; });
+        check_corrupt_header(path, "n_state past the end of the file", [](auto& header) { header.n_state = 64; });
+        // Counts whose byte sizes wrap around to something small.
+        check_corrupt_header(path, "an n_params that overflows", [](auto& header) {
+            header.n_params = std::numeric_limits<std::uint64_t>::max() / 8 + 1;
+        });
+        check_corrupt_header(path, "an n_state that overflows", [](auto& header) {
+            header.n_state = std::numeric_limits<std::uint64_t>::max() / 8 + 1;
+        });
+
+        checkpoint::save(path, make_snapshot<float>(5, 1, false));
+        check("rejects a float checkpoint read as double",
+              throws<std::runtime_error>([&] { checkpoint::MappedCheckpoint<double> mapped(path); }));
+        checkpoint::save(path, make_snapshot<double>(5, 1, false));
+        check("rejects a double checkpoint read as float",
+              throws<std::runtime_error>([&] { checkpoint::MappedCheckpoint<float> mapped(path); }));
+
+        check("rejects a missing file",
+              throws<std::system_error>([&] { checkpoint::MappedCheckpoint<double> mapped(dir + "/missing"); }));
+    }
+
+    void check_async(const std::string& dir) {
+        const std::string path = dir + "/async";
+        checkpoint::Snapshot<double> last;
+        {
+            checkpoint::AsyncCheckpointer<double> checkpointer(path);
+            for (std::uint64_t epoch = 1; epoch <= 20; ++epoch) {
+                last = make_snapshot<double>(16, epoch, epoch % 2 == 0);
+                checkpointer.submit(last);
+            }
+            checkpointer.flush();
+            const checkpoint::MappedCheckpoint<double> mapped(path);
+            check("AsyncCheckpointer: flush leaves the latest snapshot on disk", matches(mapped, last));
+            check("AsyncCheckpointer: no temporary file is left", ::access((path + ".tmp").c_str(), F_OK) != 0);
+        }
+
+        // A failed write is reported by the next flush().
+        checkpoint::AsyncCheckpointer<double> failing(dir + "/missing_dir/async");
+        failing.submit(last);
+        check("AsyncCheckpointer: flush rethrows a failed write",
+              throws<std::system_error>([&] { failing.flush(); }));
+    }
+
+}
+
+int main() {
+    const std::string dir = temp_dir();
+    check_round_trip<double>(dir, "double");
+    check_round_trip<float>(dir, "float");
+    check_rejections(dir);
+    check_async(dir);
+    for (const char* name : {"round_trip_double", "round_trip_float", "corrupt", "async"}) {
+        ::unlink((dir + "/" + name).c_str());
+    }
+    ::rmdir(dir.c_str());
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
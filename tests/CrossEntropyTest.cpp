@@ -0,0 +1,277 @@
+// The fused cross-entropy losses: value() and compute() against a naive
+// log-sigmoid or log-sum-exp in long double; the gradients of compute()
+// (through the graph) and of gradient() against central finite differences;
+// finite losses and gradients at logits of +-1000, where the naive formulas
+// overflow; and rejection of bad labels and mismatched sizes.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "loss/crossentropy/BinaryCrossEntropyWithLogits.h"
+#include "loss/crossentropy/SoftmaxCrossEntropy.h"
+
+namespace {
+
+    int failures = 0;
+
+    constexpr size_t n_samples = 9;
+    constexpr size_t n_classes = 4;
+
+    void check(const std::string& what, const bool ok, const double error) {
+        if (!ok) ++failures;
+        std::printf("%-4s %-58s error %.2e\n", ok ? "ok" : "FAIL", what.c_str(), error);
+    }
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    // Mean of -y log(sigmoid(z)) - (1 - y) log(1 - sigmoid(z)).
+    long double naive_sigmoid(const std::vector<double>& logits, const std::vector<double>& targets) {
+        long double total = 0;
+        for (size_t i = 0; i < logits.size(); ++i) {
+            const long double p = 1 / (1 + std::exp(-static_cast<long double>(logits[i])));
+            total -= targets[i] * std::log(p) + (1 - targets[i]) * std::log(1 - p);
+        }
+        return total / logits.size();
+    }
+
+    // Mean of log(sum_j exp(z_ij)) - z_i,label.
+    long double naive_softmax(const std::vector<double>& logits, const std::vector<double>& labels) {
+        long double total = 0;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            long double sum = 0;
+            for (size_t j = 0; j < n_classes; ++j) {
+                sum += std::exp(static_cast<long double>(logits[i * n_classes + j]));
+            }
+            total += std::log(sum) - logits[i * n_classes + static_cast<size_t>(labels[i])];
+        }
+        return total / labels.size();
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<autodiff::VariablePtr<T>> leaves(const std::vector<T>& values) {
+        std::vector<autodiff::VariablePtr<T>> result;
+        for (const T v : values) result.push_back(autodiff::BasicVariable<T>::create(v, true));
+        return result;
+    }
+
+    // Loss value and dL/dz through compute() and backward().
+    template <autodiff::Scalar T>
+    T graph_gradient(LossFunction<T>& loss, const std::vector<T>& logits, const std::vector<T>& y,
+                     std::vector<T>& grad) {
+        auto z = leaves(logits);
+        const auto value = loss.compute(z, y);
+        value->backward();
+        grad.clear();
+        for (const auto& leaf : z) grad.push_back(static_cast<T>(leaf->grad()));
+        return value->value();
+    }
+
+    template <autodiff::Scalar T>
+    T direct_gradient(LossFunction<T>& loss, const std::vector<T>& logits, const std::vector<T>& y,
+                      std::vector<T>& grad) {
+        grad.assign(logits.size(), T(0));
+        return loss.gradient(logits, y, grad);
+    }
+
+    // Largest |grad - central difference of value()|.
+    double finite_difference_error(LossFunction<double>& loss, const std::vector<double>& logits,
+                                   const std::vector<double>& y, const std::vector<double>& grad) {
+        constexpr double h = 1e-6;
+        double error = 0;
+        for (size_t i = 0; i < logits.size(); ++i) {
+            auto plus = logits;
+            auto minus = logits;
+            plus[i] += h;
+            minus[i] -= h;
+            const double estimate = (loss.value(plus, y) - loss.value(minus, y)) / (2 * h);
+            error = std::max(error, std::fabs(grad[i] - estimate));
+        }
+        return error;
+    }
+
+    bool all_finite(const std::vector<double>& values) {
+        return std::all_of(values.begin(), values.end(), [](const double v) { return std::isfinite(v); });
+    }
+
+    bool rejects(const std::function<void()>& call) {
+        try {
+            call();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    }
+
+    void check_values(const std::vector<double>& sigmoid_logits, const std::vector<double>& targets,
+                      const std::vector<double>& softmax_logits, const std::vector<double>& labels) {
+        BinaryCrossEntropyWithLogits<double> bce;
+        SoftmaxCrossEntropy<double> softmax(n_classes);
+        std::vector<double> grad;
+
+        const long double bce_expected = naive_sigmoid(sigmoid_logits, targets);
+        const double bce_value_error = std::fabs(bce.value(sigmoid_logits, targets) - bce_expected) / bce_expected;
+        check("BCE: value() matches the naive log-sigmoid", bce_value_error <= 1e-14, bce_value_error);
+        const double bce_graph_error =
+            std::fabs(graph_gradient(bce, sigmoid_logits, targets, grad) - bce_expected) / bce_expected;
+        check("BCE: compute() matches the naive log-sigmoid", bce_graph_error <= 1e-14, bce_graph_error);
+
+        const long double softmax_expected = naive_softmax(softmax_logits, labels);
+        const double softmax_value_error =
+            std::fabs(softmax.value(softmax_logits, labels) - softmax_expected) / softmax_expected;
+        check("Softmax: value() matches the naive log-sum-exp", softmax_value_error <= 1e-14, softmax_value_error);
+        const double softmax_graph_error =
+            std::fabs(graph_gradient(softmax, softmax_logits, labels, grad) - softmax_expected) / softmax_expected;
+        check("Softmax: compute() matches the naive log-sum-exp", softmax_graph_error <= 1e-14, softmax_graph_error);
+
+        // float keeps its sums in double, so it is as accurate as its inputs.
+        BinaryCrossEntropyWithLogits<float> bce_float;
+        const std::vector<float> float_logits(sigmoid_logits.begin(), sigmoid_logits.end());
+        const std::vector<float> float_targets(targets.begin(), targets.end());
+        const long double float_expected = naive_sigmoid({float_logits.begin(), float_logits.end()},
+                                                         {float_targets.begin(), float_targets.end()});
+        const double float_error =
+            std::fabs(bce_float.value(float_logits, float_targets) - float_expected) / float_expected;
+        check("BCE<float>: value() matches the naive log-sigmoid", float_error <= 1e-6, float_error);
+    }
+
+    void check_gradients(const std::vector<double>& sigmoid_logits, const std::vector<double>& targets,
+                         const std::vector<double>& softmax_logits, const std::vector<double>& labels) {
+        BinaryCrossEntropyWithLogits<double> bce;
+        SoftmaxCrossEntropy<double> softmax(n_classes);
+        std::vector<double> grad;
+
+        graph_gradient(bce, sigmoid_logits, targets, grad);
+        double error = finite_difference_error(bce, sigmoid_logits, targets, grad);
+        check("BCE: compute() gradient matches finite differences", error <= 1e-8, error);
+        direct_gradient(bce, sigmoid_logits, targets, grad);
+        error = finite_difference_error(bce, sigmoid_logits, targets, grad);
+        check("BCE: gradient() matches finite differences", error <= 1e-8, error);
+
+        graph_gradient(softmax, softmax_logits, labels, grad);
+        error = finite_difference_error(softmax, softmax_logits, labels, grad);
+        check("Softmax: compute() gradient matches finite differences", error <= 1e-8, error);
+        direct_gradient(softmax, softmax_logits, labels, grad);
+        error = finite_difference_error(softmax, softmax_logits, labels, grad);
+        check("Softmax: gradient() matches finite differences", error <= 1e-8, error);
+    }
+
+    void check_extreme_logits() {
+        BinaryCrossEntropyWithLogits<double> bce;
+        SoftmaxCrossEntropy<double> softmax(3);
+        std::vector<double> graph;
+        std::vector<double> direct;
+
+        // Confidently wrong, confidently right, and a soft target on each side.
+        const std::vector<double> z = {1000, -1000, 1000, -1000};
+        const std::vector<double> y = {0, 0, 0.25, 0.25};
+        const double bce_expected = (1000 + 0 + 750 + 250) / 4.0;
+        const double bce_graph = graph_gradient(bce, z, y, graph);
+        const double bce_direct = direct_gradient(bce, z, y, direct);
+        const std::vector<double> bce_grad_expected = {0.25, 0, 0.1875, -0.0625};
+        double grad_error = 0;
+        for (size_t i = 0; i < z.size(); ++i) {
+            grad_error = std::max({grad_error, std::fabs(graph[i] - bce_grad_expected[i]),
+                                   std::fabs(direct[i] - bce_grad_expected[i])});
+        }
+        check("BCE: finite loss and gradients at logits of +-1000",
+              std::fabs(bce_graph - bce_expected) <= 1e-12 && std::fabs(bce_direct - bce_expected) <= 1e-12 &&
+                  std::fabs(bce.value(z, y) - bce_expected) <= 1e-12 && all_finite(graph) && all_finite(direct) &&
+                  grad_error <= 1e-12,
+              grad_error);
+
+        // Sample 0 puts its label on the -1000 logit, sample 1 on the +1000 one.
+        const std::vector<double> logits = {1000, -1000, 0, 1000, -1000, 0};
+        const std::vector<double> labels = {1, 0};
+        const double softmax_expected = (2000 + 0) / 2.0;
+        const double softmax_graph = graph_gradient(softmax, logits, labels, graph);
+        const double softmax_direct = direct_gradient(softmax, logits, labels, direct);
+        const std::vector<double> softmax_grad_expected = {0.5, -0.5, 0, 0, 0, 0};
+        grad_error = 0;
+        for (size_t i = 0; i < logits.size(); ++i) {
+            grad_error = std::max({grad_error, std::fabs(graph[i] - softmax_grad_expected[i]),
+                                   std::fabs(direct[i] - softmax_grad_expected[i])});
+        }
+        check("Softmax: finite loss and gradients at logits of +-1000",
+              std::fabs(softmax_graph - softmax_expected) <= 1e-12 &&
+                  std::fabs(softmax_direct - softmax_expected) <= 1e-12 &&
+                  std::fabs(softmax.value(logits, labels) - softmax_expected) <= 1e-12 && all_finite(graph) &&
+                  all_finite(direct) && grad_error <= 1e-12,
+              grad_error);
+    }
+
+    void check_rejections() {
+        BinaryCrossEntropyWithLogits<double> bce;
+        SoftmaxCrossEntropy<double> softmax(3);
+        const std::vector<double> logits(6, 0.5);
+        std::vector<double> grad(6);
+        std::vector<double> short_grad(5);
+        auto z = leaves(logits);
+
+        const std::pair<double, const char*> bad_labels[] = {{-1.0, "-1"}, {3.0, "3"}, {1.5, "1.5"}};
+        for (const auto& [label, text] : bad_labels) {
+            const std::vector<double> labels = {0, label};
+            const std::string name = std::string("Softmax: rejects label ") + text;
+            check(name + " in value()", rejects([&] { softmax.value(logits, labels); }));
+            check(name + " in compute()", rejects([&] { softmax.compute(z, labels); }));
+            check(name + " in gradient()", rejects([&] { softmax.gradient(logits, labels, grad); }));
+        }
+        const std::vector<double> three_labels = {0, 1, 2};
+        check("Softmax: rejects logits that are not n_classes per label",
+              rejects([&] { softmax.value(logits, three_labels); }) &&
+                  rejects([&] { softmax.compute(z, three_labels); }) &&
+                  rejects([&] { softmax.gradient(logits, three_labels, grad); }));
+        check("Softmax: rejects a grad of the wrong size",
+              rejects([&] { softmax.gradient(logits, {0, 1}, short_grad); }));
+        check("Softmax: rejects zero classes", rejects([&] {
+                  SoftmaxCrossEntropy<double> empty(0);
+                  empty.value(logits, {0, 1});
+              }));
+
+        const std::vector<double> five_targets(5, 1.0);
+        check("BCE: rejects mismatched logits and targets",
+              rejects([&] { bce.value(logits, five_targets); }) && rejects([&] { bce.compute(z, five_targets); }) &&
+                  rejects([&] { bce.gradient(logits, five_targets, grad); }));
+        check("BCE: rejects a grad of the wrong size",
+              rejects([&] { bce.gradient(logits, std::vector<double>(6, 1.0), short_grad); }));
+    }
+
+}
+
+int main() {
+    std::mt19937_64 rng(23);
+    std::normal_distribution<double> normal(0, 3);
+    std::uniform_real_distribution<double> uniform(0, 1);
+    std::uniform_int_distribution<int> label(0, n_classes - 1);
+
+    std::vector<double> sigmoid_logits(n_samples);
+    std::vector<double> targets(n_samples);
+    for (size_t i = 0; i < n_samples; ++i) {
+        sigmoid_logits[i] = normal(rng);
+        targets[i] = i % 3 == 0 ? uniform(rng) : (i % 3 == 1 ? 1 : 0);
+    }
+    std::vector<double> softmax_logits(n_samples * n_classes);
+    std::vector<double> labels(n_samples);
+    for (auto& z : softmax_logits) z = normal(rng);
+    for (auto& l : labels) l = label(rng);
+
+    check_values(sigmoid_logits, targets, softmax_logits, labels);
+    check_gradients(sigmoid_logits, targets, softmax_logits, labels);
+    check_extreme_logits();
+    check_rejections();
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,292 @@
+// Allreduce and barrier across forked ranks for SharedMemoryCommunicator and
+// SocketCommunicator::unix_ring, attaching past a stale shared memory segment
+// left by an earlier run, and DataParallel steps on two ranks against the same
+// steps taken by one process on the combined batch. launch() throws if any
+// rank fails.
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "distributed/DataParallel.h"
+#include "distributed/Launch.h"
+#include "distributed/SharedMemoryCommunicator.h"
+#include "distributed/SocketCommunicator.h"
+#include "inference/Inference.h"
+#include "loss/mse/MSE.h"
+#include "model/sequential/Sequential.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    using namespace distributed;
+
+    enum class Kind { shared_memory, unix_ring };
+
+    int failures = 0;
+
+    // Unique per test process, so concurrent runs do not share segments or
+    // sockets. Taken before fork, so all ranks agree on it.
+    std::string unique_name(const char* what) {
+        return std::string("gd_test_") + what + "_" + std::to_string(::getpid());
+    }
+
+    std::unique_ptr<Communicator> connect(const Kind kind, const std::string& name, const size_t rank,
+                                          const size_t size) {
+        if (kind == Kind::shared_memory) {
+            // A small capacity so longer vectors are reduced in several pieces.
+            return std::make_unique<SharedMemoryCommunicator>(name, rank, size, 1000);
+        }
+        return SocketCommunicator::unix_ring(name, rank, size);
+    }
+
+    // Rank r contributes (r + 1) / 10 + i / 1000 at index i.
+    double contribution(const size_t rank, const size_t i) {
+        return (static_cast<double>(rank) + 1) * 0.1 + static_cast<double>(i) * 1e-3;
+    }
+
+    // Every rank must end with the sum over ranks, and with bit-identical values.
+    // The ranks compare results through a MAP_SHARED page set up before fork.
+    void check_allreduce(const Kind kind, const char* label, double* shared) {
+        bool ok = true;
+        std::string error;
+        for (const size_t size : {1, 2, 3, 4}) {
+            for (const size_t length : {0, 1, 5, 1001, 100000}) {
+                const std::string name = unique_name("allreduce");
+                try {
+                    launch(size, [&](const size_t rank, const size_t n) {
+                        const auto comm = connect(kind, name, rank, n);
+                        if (comm->rank() != rank || comm->size() != n) {
+                            throw std::runtime_error("wrong rank or size");
+                        }
+                        std::vector<double> values(length);
+                        for (size_t i = 0; i < length; ++i) values[i] = contribution(rank, i);
+                        comm->allreduce(values);
+                        for (size_t i = 0; i < length; ++i) {
+                            double expected = 0;
+                            for (size_t r = 0; r < n; ++r) expected += contribution(r, i);
+                            if (std::fabs(values[i] - expected) > 1e-9) {
+                                throw std::runtime_error("wrong sum at " + std::to_string(i));
+                            }
+                        }
+                        if (length > 0) shared[rank] = values[length / 2];
+                        comm->barrier();
+                        for (size_t r = 0; length > 0 && r < n; ++r) {
+                            if (shared[r] != shared[0]) throw std::runtime_error("ranks disagree");
+                        }
+                        comm->barrier();
+                    });
+                } catch (const std::exception& e) {
+                    ok = false;
+                    error = std::to_string(size) + " ranks, length " + std::to_string(length) + ": " + e.what();
+                }
+            }
+        }
+        if (!ok) ++failures;
+        std::printf("%-4s %s allreduce over 1-4 ranks%s%s\n", ok ? "ok" : "FAIL", label,
+                    ok ? "" : " - ", error.c_str());
+    }
+
+    // Leaves a segment that looks fully initialised, as a crashed run would, and
+    // starts rank 1 well before rank 0. Rank 1 must not use the stale segment.
+    void check_stale_segment() {
+        const std::string name = unique_name("stale");
+        const std::string path = "/" + name;
+        const int fd = ::shm_open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        bool ok = fd >= 0 && ::ftruncate(fd, 1 << 20) == 0;
+        if (ok) {
+            void* base = ::mmap(nullptr, 1 << 20, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ok = base != MAP_FAILED;
+            if (ok) {
+                // ready, size and capacity, matching the layout of the header.
+                const std::uint32_t ready = 0x47445348;
+                const std::uint32_t size = 2;
+                const std::uint64_t capacity = 1000;
+                std::memcpy(base, &ready, sizeof(ready));
+                std::memcpy(static_cast<char*>(base) + 4, &size, sizeof(size));
+                std::memcpy(static_cast<char*>(base) + 8, &capacity, sizeof(capacity));
+                ::munmap(base, 1 << 20);
+            }
+        }
+        if (fd >= 0) ::close(fd);
+
+        std::string error;
+        if (ok) {
+            try {
+                launch(2, [&](const size_t rank, const size_t n) {
+                    if (rank == 0) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                    SharedMemoryCommunicator comm(name, rank, n, 1000, std::chrono::seconds(10));
+                    std::vector<double> values = {static_cast<double>(rank + 1)};
+                    comm.allreduce(values);
+                    if (values[0] != 3) throw std::runtime_error("wrong sum");
+                });
+            } catch (const std::exception& e) {
+                ok = false;
+                error = e.what();
+            }
+        } else {
+            error = "could not create the stale segment";
+        }
+        ::shm_unlink(path.c_str());
+        if (!ok) ++failures;
+        std::printf("%-4s shared memory attach ignores a stale segment%s%s\n", ok ? "ok" : "FAIL",
+                    ok ? "" : " - ", error.c_str());
+    }
+
+    using Variable = std::shared_ptr<autodiff::BasicVariable<double>>;
+    using Matrix = std::vector<std::vector<double>>;
+
+    // An odd row count, so the two shards differ in size.
+    constexpr size_t n_rows = 203;
+    constexpr size_t n_features = 5;
+    constexpr size_t steps = 20;
+    constexpr double learning_rate = 0.05;
+    // Each rank's weights go to its own block of the shared page.
+    constexpr size_t block = 64;
+
+    std::vector<Variable> make_weights(const double scale) {
+        std::vector<Variable> w;
+        for (size_t j = 0; j <= n_features; ++j) {
+            w.push_back(autodiff::BasicVariable<double>::create(scale * static_cast<double>(j + 1), true));
+        }
+        return w;
+    }
+
+    // Publishes this rank's weights and checks that every rank holds the same
+    // values, and that they match `expected` up to summation order.
+    void compare_weights(Communicator& comm, const std::vector<double>& weights, const std::vector<double>& expected,
+                         double* shared) {
+        if (weights.size() != expected.size() || weights.size() > block) {
+            throw std::runtime_error("wrong parameter count");
+        }
+        for (size_t j = 0; j < weights.size(); ++j) {
+            if (std::fabs(weights[j] - expected[j]) > 1e-12) {
+                throw std::runtime_error("weight " + std::to_string(j) + " differs from the single-process step");
+            }
+            shared[comm.rank() * block + j] = weights[j];
+        }
+        comm.barrier();
+        for (size_t r = 0; r < comm.size(); ++r) {
+            for (size_t j = 0; j < weights.size(); ++j) {
+                if (shared[r * block + j] != weights[j]) throw std::runtime_error("ranks disagree");
+            }
+        }
+        comm.barrier();
+    }
+
+    // DataParallel on two ranks, each holding one shard, against Vanilla on all
+    // rows: one train() step, then fit() for `steps` more, for a linear model,
+    // and train() steps of a small MLP. Rank 1 starts from different weights,
+    // so sync_parameters must copy rank 0's.
+    void check_data_parallel(const Kind kind, const char* label, double* shared) {
+        std::mt19937_64 rng(36);
+        std::normal_distribution<double> normal;
+        Matrix X(n_rows, std::vector<double>(n_features));
+        std::vector<double> y(n_rows);
+        std::vector<double> packed;
+        for (size_t i = 0; i < n_rows; ++i) {
+            double target = 0.3;
+            for (size_t j = 0; j < n_features; ++j) {
+                X[i][j] = normal(rng);
+                target += 0.2 * static_cast<double>(j + 1) * X[i][j];
+                packed.push_back(X[i][j]);
+            }
+            y[i] = target + 0.1 * normal(rng);
+        }
+
+        MSE<double> mse;
+        Vanilla<double> optimizer;
+        auto w = make_weights(0.01);
+        const double first_loss = optimizer.train(w, X, y, mse, learning_rate);
+        const auto after_step = inference::values(w);
+        const auto losses = optimizer.fit(w, X, y, mse, learning_rate, steps);
+        const auto after_fit = inference::values(w);
+
+        const MatrixView<double> all_rows{packed.data(), n_rows, n_features, n_features};
+        const auto net = Sequential<double>::mlp({n_features, 4, 1}, 3, 1);
+        std::vector<double> net_losses;
+        for (size_t s = 0; s < 3; ++s) {
+            net_losses.push_back(optimizer.train(*net, all_rows, y, mse, learning_rate));
+        }
+        const auto net_weights = inference::values(net->parameters());
+
+        const std::string name = unique_name("data_parallel");
+        bool ok = true;
+        std::string error;
+        try {
+            launch(2, [&](const size_t rank, const size_t n) {
+                const auto comm = connect(kind, name, rank, n);
+                const auto rows = shard(n_rows, rank, n);
+                const Matrix X_shard(X.begin() + rows.begin, X.begin() + rows.end);
+                const std::vector<double> y_shard(y.begin() + rows.begin, y.begin() + rows.end);
+
+                Vanilla<double> local;
+                DataParallel<double> parallel(local, *comm);
+                auto w_rank = make_weights(rank == 0 ? 0.01 : 5.0);
+                parallel.sync_parameters(w_rank);
+                if (std::fabs(parallel.train(w_rank, X_shard, y_shard, mse, learning_rate) - first_loss) > 1e-12) {
+                    throw std::runtime_error("step loss differs from the single-process step");
+                }
+                compare_weights(*comm, inference::values(w_rank), after_step, shared);
+
+                const auto rank_losses = parallel.fit(w_rank, X_shard, y_shard, mse, learning_rate, steps);
+                for (size_t e = 0; e < steps; ++e) {
+                    if (std::fabs(rank_losses[e] - losses[e]) > 1e-12) {
+                        throw std::runtime_error("fit loss differs at step " + std::to_string(e));
+                    }
+                }
+                compare_weights(*comm, inference::values(w_rank), after_fit, shared);
+
+                const auto rank_net = Sequential<double>::mlp({n_features, 4, 1}, rank == 0 ? 3 : 99, 1);
+                parallel.sync_parameters(*rank_net);
+                const MatrixView<double> view{packed.data() + rows.begin * n_features, rows.end - rows.begin,
+                                              n_features, n_features};
+                for (size_t s = 0; s < net_losses.size(); ++s) {
+                    if (std::fabs(parallel.train(*rank_net, view, y_shard, mse, learning_rate) - net_losses[s]) >
+                        1e-12) {
+                        throw std::runtime_error("model loss differs at step " + std::to_string(s));
+                    }
+                }
+                compare_weights(*comm, inference::values(rank_net->parameters()), net_weights, shared);
+            });
+        } catch (const std::exception& e) {
+            ok = false;
+            error = e.what();
+        }
+        if (!ok) ++failures;
+        std::printf("%-4s %s DataParallel on 2 ranks matches one process on the combined batch%s%s\n",
+                    ok ? "ok" : "FAIL", label, ok ? "" : " - ", error.c_str());
+    }
+
+}
+
+int main() {
+    void* page = ::mmap(nullptr, 4096, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED) {
+        std::perror("mmap");
+        return EXIT_FAILURE;
+    }
+    auto* shared = static_cast<double*>(page);
+
+    check_allreduce(Kind::shared_memory, "shared memory", shared);
+    check_allreduce(Kind::unix_ring, "unix ring", shared);
+    check_stale_segment();
+    check_data_parallel(Kind::shared_memory, "shared memory", shared);
+    check_data_parallel(Kind::unix_ring, "unix ring", shared);
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
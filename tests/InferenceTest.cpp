@@ -0,0 +1,153 @@
+// Graph-free inference against the autodiff graph: inference::predict on a
+// MatrixView, nested vectors and a CsrMatrix must give the predictions of the
+// graph w[n] + sum_j w[j] * x[j], and inference::evaluate the loss that
+// compute() gives on those graph predictions. Inputs are large enough to be
+// split across threads. Mismatched target counts must be rejected.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "inference/Inference.h"
+#include "loss/crossentropy/BinaryCrossEntropyWithLogits.h"
+#include "loss/mse/MSE.h"
+
+namespace {
+
+    int failures = 0;
+
+    constexpr size_t n_rows = 3001;
+    constexpr size_t n_features = 37;
+
+    void check(const std::string& what, const bool ok, const double error) {
+        if (!ok) ++failures;
+        std::printf("%-4s %-52s relative error %.2e\n", ok ? "ok" : "FAIL", what.c_str(), error);
+    }
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    template <autodiff::Scalar T>
+    struct Problem {
+        std::vector<autodiff::VariablePtr<T>> w;
+        std::vector<std::vector<T>> rows;
+        std::vector<T> packed;
+        CsrMatrix<T> sparse;
+        std::vector<T> y_true;
+
+        MatrixView<T> view() const { return {packed.data(), rows.size(), n_features, n_features}; }
+    };
+
+    // About two thirds of the features are zero, so the CSR rows are sparse.
+    template <autodiff::Scalar T>
+    Problem<T> make_problem() {
+        std::mt19937_64 rng(3);
+        std::normal_distribution<double> normal;
+        std::uniform_int_distribution<int> keep(0, 2);
+        Problem<T> problem;
+        for (size_t j = 0; j <= n_features; ++j) {
+            problem.w.push_back(autodiff::BasicVariable<T>::create(static_cast<T>(normal(rng)), true));
+        }
+        for (size_t i = 0; i < n_rows; ++i) {
+            std::vector<T> row(n_features);
+            for (auto& v : row) v = keep(rng) == 0 ? static_cast<T>(normal(rng)) : T(0);
+            problem.packed.insert(problem.packed.end(), row.begin(), row.end());
+            problem.rows.push_back(std::move(row));
+            problem.y_true.push_back(static_cast<T>(normal(rng) > 0 ? 1 : 0));
+        }
+        problem.sparse = CsrMatrix<T>::from_dense(problem.rows);
+        return problem;
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<autodiff::VariablePtr<T>> graph_predictions(const Problem<T>& problem) {
+        std::vector<autodiff::VariablePtr<T>> y;
+        for (const auto& row : problem.rows) {
+            std::vector<autodiff::VariablePtr<T>> terms{problem.w[n_features]};
+            for (size_t j = 0; j < n_features; ++j) {
+                terms.push_back(problem.w[j] * row[j]);
+            }
+            y.push_back(autodiff::sum(terms));
+        }
+        return y;
+    }
+
+    // Largest |a - b| relative to the largest |b|.
+    template <autodiff::Scalar T>
+    double relative_error(const std::vector<T>& a, const std::vector<autodiff::VariablePtr<T>>& b) {
+        double error = 0;
+        double scale = std::numeric_limits<double>::min();
+        for (size_t i = 0; i < a.size(); ++i) {
+            error = std::max(error, std::fabs(static_cast<double>(a[i]) - b[i]->value()));
+            scale = std::max(scale, std::fabs(static_cast<double>(b[i]->value())));
+        }
+        return a.size() == b.size() ? error / scale : std::numeric_limits<double>::infinity();
+    }
+
+    bool rejects(const std::function<void()>& call) {
+        try {
+            call();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    }
+
+    template <autodiff::Scalar T>
+    void check_all(const std::string& type, const double tolerance) {
+        const Problem<T> problem = make_problem<T>();
+        auto graph = graph_predictions(problem);
+
+        const auto check_predictions = [&](const std::string& input, const std::vector<T>& y) {
+            const double error = relative_error(y, graph);
+            check(type + ": predict on " + input, error <= tolerance, error);
+        };
+        check_predictions("a MatrixView", inference::predict(problem.w, problem.view()));
+        check_predictions("nested vectors", inference::predict(problem.w, problem.rows));
+        check_predictions("a CsrMatrix", inference::predict(problem.w, problem.sparse));
+
+        MSE<T> mse;
+        BinaryCrossEntropyWithLogits<T> bce;
+        for (LossFunction<T>* loss : std::initializer_list<LossFunction<T>*>{&mse, &bce}) {
+            const std::string name = loss == &mse ? "MSE" : "BCE";
+            const double expected = loss->compute(graph, problem.y_true)->value();
+            const auto check_loss = [&](const std::string& input, const T value) {
+                const double error = std::fabs(value - expected) / std::fabs(expected);
+                check(type + ": evaluate " + name + " on " + input, error <= tolerance, error);
+            };
+            check_loss("a MatrixView", inference::evaluate(problem.w, problem.view(), problem.y_true, *loss));
+            check_loss("nested vectors", inference::evaluate(problem.w, problem.rows, problem.y_true, *loss));
+            check_loss("a CsrMatrix", inference::evaluate(problem.w, problem.sparse, problem.y_true, *loss));
+        }
+
+        const std::vector<T> short_y(problem.y_true.begin(), problem.y_true.end() - 1);
+        check(type + ": evaluate rejects too few targets (MatrixView)",
+              rejects([&] { inference::evaluate(problem.w, problem.view(), short_y, mse); }));
+        check(type + ": evaluate rejects too few targets (nested vectors)",
+              rejects([&] { inference::evaluate(problem.w, problem.rows, short_y, mse); }));
+        check(type + ": evaluate rejects too few targets (CsrMatrix)",
+              rejects([&] { inference::evaluate(problem.w, problem.sparse, short_y, mse); }));
+
+        const std::vector<T> y_pred(problem.y_true.size(), T(0));
+        check(type + ": MSE::value rejects too few targets", rejects([&] { mse.value(y_pred, short_y); }));
+        check(type + ": MSE::compute rejects too few targets", rejects([&] { mse.compute(graph, short_y); }));
+    }
+
+}
+
+int main() {
+    check_all<double>("double", 1e-12);
+    check_all<float>("float", 1e-5);
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,132 @@
+// Checks the error bounds documented in autodiff/kernels/Transcendental.h on
+// whichever kernel table is selected; ctest runs it once as dispatched and once
+// with AUTODIFF_KERNELS=scalar. An optional argument sets the samples per range.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+#include "autodiff/kernels/Kernels.h"
+
+namespace {
+
+    using namespace autodiff;
+
+    int failures = 0;
+
+    // |got - ref| in units of the last place of ref rounded to T.
+    template <typename T>
+    double ulp_error(const T got, const long double ref) {
+        if (std::isnan(ref)) return std::isnan(got) ? 0 : INFINITY;
+        const T rounded = static_cast<T>(ref);
+        if (std::isinf(rounded)) return got == rounded ? 0 : INFINITY;
+        const long double magnitude = std::fabs(static_cast<long double>(rounded));
+        long double ulp = std::nextafter(std::fabs(rounded), std::numeric_limits<T>::infinity()) - magnitude;
+        if (ulp == 0) ulp = std::numeric_limits<T>::denorm_min();
+        return static_cast<double>(std::fabs(static_cast<long double>(got) - ref) / ulp);
+    }
+
+    enum class Spacing { uniform, logarithmic };
+
+    template <typename T, typename Kernel, typename Reference>
+    void check(const char* name, Kernel kernel, Reference reference, const double lo, const double hi,
+               const double bound, const size_t samples, const Spacing spacing = Spacing::uniform) {
+        std::mt19937_64 rng(42);
+        std::vector<T> x(samples);
+        std::vector<T> y(samples);
+        if (spacing == Spacing::logarithmic) {
+            std::uniform_real_distribution<double> exponent(std::log(lo), std::log(hi));
+            for (auto& v : x) v = static_cast<T>(std::exp(exponent(rng)));
+        } else {
+            std::uniform_real_distribution<double> value(lo, hi);
+            for (auto& v : x) v = static_cast<T>(value(rng));
+        }
+        kernel(std::span<const T>(x), std::span<T>(y));
+
+        double worst = 0;
+        T worst_x = 0;
+        for (size_t i = 0; i < samples; ++i) {
+            const double error = ulp_error(y[i], reference(static_cast<long double>(x[i])));
+            if (!(error <= worst)) {
+                worst = error;
+                worst_x = x[i];
+            }
+        }
+        const bool ok = worst <= bound;
+        if (!ok) ++failures;
+        std::printf("%-4s %-6s %s [%g, %g]: %.3f ulp (bound %.1f) at %.17g\n", ok ? "ok" : "FAIL", name,
+                    sizeof(T) == 4 ? "float " : "double", lo, hi, worst, bound, static_cast<double>(worst_x));
+    }
+
+    template <typename T>
+    void expect(const char* what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s (%s)\n", ok ? "ok" : "FAIL", what, sizeof(T) == 4 ? "float" : "double");
+    }
+
+    template <typename T>
+    void check_specials() {
+        constexpr T inf = std::numeric_limits<T>::infinity();
+        constexpr T nan = std::numeric_limits<T>::quiet_NaN();
+        const std::vector<T> x = {inf, -inf, nan, 0, T(-1)};
+        std::vector<T> y(x.size());
+
+        kernels::exp<T>(x, y);
+        expect<T>("exp(inf) = inf, exp(-inf) = 0, exp(NaN) = NaN",
+                  y[0] == inf && y[1] == 0 && std::isnan(y[2]) && y[3] == 1);
+        kernels::log<T>(x, y);
+        expect<T>("log(inf) = inf, log(0) = -inf, log(x < 0) = NaN",
+                  y[0] == inf && std::isnan(y[1]) && std::isnan(y[2]) && y[3] == -inf && std::isnan(y[4]));
+        kernels::tanh<T>(x, y);
+        expect<T>("tanh(+-inf) = +-1, tanh(NaN) = NaN", y[0] == 1 && y[1] == -1 && std::isnan(y[2]) && y[3] == 0);
+        kernels::sin<T>(x, y);
+        expect<T>("sin(+-inf) = NaN, sin(NaN) = NaN", std::isnan(y[0]) && std::isnan(y[1]) && std::isnan(y[2]));
+        kernels::cos<T>(x, y);
+        expect<T>("cos(+-inf) = NaN, cos(0) = 1", std::isnan(y[0]) && std::isnan(y[1]) && y[3] == 1);
+    }
+
+    // Bounds from the table in Transcendental.h.
+    template <typename T>
+    void check_all(const size_t n) {
+        constexpr bool single = sizeof(T) == 4;
+        const double exp_lo = single ? -104 : -745;
+        const double exp_hi = single ? 88.7 : 709.7;
+        const double trig_limit = single ? 8192 : 1e5;
+        const auto exp_ref = [](const long double v) { return std::exp(v); };
+        const auto log_ref = [](const long double v) { return std::log(v); };
+        const auto tanh_ref = [](const long double v) { return std::tanh(v); };
+        const auto sin_ref = [](const long double v) { return std::sin(v); };
+        const auto cos_ref = [](const long double v) { return std::cos(v); };
+
+        check<T>("exp", kernels::exp<T>, exp_ref, exp_lo, exp_hi, 1.0, n);
+        check<T>("exp", kernels::exp<T>, exp_ref, -1, 1, 1.0, n);
+        check<T>("log", kernels::log<T>, log_ref, std::numeric_limits<T>::denorm_min(),
+                 std::numeric_limits<T>::max(), 2.0, n, Spacing::logarithmic);
+        check<T>("log", kernels::log<T>, log_ref, 0.5, 2, 2.0, n);
+        check<T>("tanh", kernels::tanh<T>, tanh_ref, -30, 30, 3.5, n);
+        check<T>("tanh", kernels::tanh<T>, tanh_ref, 1e-30, 1, 3.5, n, Spacing::logarithmic);
+        check<T>("tanh", kernels::tanh<T>, tanh_ref, -1e-3, 1e-3, 3.5, n);
+        check<T>("sin", kernels::sin<T>, sin_ref, -10, 10, 2.5, n);
+        check<T>("sin", kernels::sin<T>, sin_ref, -trig_limit, trig_limit, 2.5, n);
+        check<T>("sin", kernels::sin<T>, sin_ref, -1e9, 1e9, 2.5, n);
+        check<T>("cos", kernels::cos<T>, cos_ref, -10, 10, 2.5, n);
+        check<T>("cos", kernels::cos<T>, cos_ref, -trig_limit, trig_limit, 2.5, n);
+        check<T>("cos", kernels::cos<T>, cos_ref, -1e9, 1e9, 2.5, n);
+        check_specials<T>();
+    }
+
+}
+
+int main(const int argc, char** argv) {
+    const size_t samples = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    std::printf("kernels: %s, %zu samples per range\n", kernels::isa(), samples);
+    check_all<double>(samples);
+    check_all<float>(samples);
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
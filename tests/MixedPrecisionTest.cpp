@@ -0,0 +1,125 @@
+// float32 training with master weights: fit() in float with an accumulate_t
+// copy of the parameters tracks the same run in double on a small regression
+// problem, and an update below float resolution is kept in the master copy
+// (and eventually reaches the float weight) where plain float updates lose it.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "loss/mse/MSE.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    int failures = 0;
+
+    constexpr size_t n_rows = 200;
+    constexpr size_t n_features = 3;
+    constexpr size_t epochs = 200;
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<std::shared_ptr<autodiff::BasicVariable<T>>> make_weights(const size_t n, const T value) {
+        std::vector<std::shared_ptr<autodiff::BasicVariable<T>>> w;
+        for (size_t i = 0; i < n; ++i) {
+            w.push_back(autodiff::BasicVariable<T>::create(value, true));
+        }
+        return w;
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<T> fit(const std::vector<std::vector<double>>& X, const std::vector<double>& y, const bool master,
+                       std::vector<double>& weights) {
+        std::vector<std::vector<T>> X_t;
+        for (const auto& row : X) X_t.emplace_back(row.begin(), row.end());
+        const std::vector<T> y_t(y.begin(), y.end());
+
+        Vanilla<T> optimizer;
+        optimizer.set_master_weights(master);
+        MSE<T> mse;
+        auto w = make_weights<T>(n_features + 1, 0);
+        const auto losses = optimizer.fit(w, X_t, y_t, mse, T(0.05), epochs);
+        weights.clear();
+        for (const auto& param : w) weights.push_back(param->value());
+        return losses;
+    }
+
+    // One parameter at 1, stepped `steps` times by +1e-8: under half an ulp
+    // of 1.0f, so each update rounds away in float.
+    struct Small {
+        float value;
+        double master;
+    };
+
+    constexpr double small_step = 1e-8;
+
+    Small small_updates(const bool master, const size_t steps) {
+        Vanilla<float> optimizer;
+        optimizer.set_master_weights(master);
+        auto w = make_weights<float>(1, 1.0f);
+        for (size_t s = 0; s < steps; ++s) {
+            w[0]->add_grad(-small_step);
+            optimizer.step(w, 1.0f);
+        }
+        const auto state = optimizer.snapshot(w).state;
+        return {w[0]->value(), state.empty() ? NAN : state[0]};
+    }
+
+}
+
+int main() {
+    std::mt19937_64 rng(26);
+    std::normal_distribution<double> normal;
+    std::vector<std::vector<double>> X(n_rows, std::vector<double>(n_features));
+    std::vector<double> y(n_rows);
+    for (size_t i = 0; i < n_rows; ++i) {
+        for (auto& x : X[i]) x = normal(rng);
+        y[i] = 1 + 2 * X[i][0] - 0.5 * X[i][1] + 0.1 * normal(rng);
+    }
+
+    std::vector<double> weights_double;
+    std::vector<double> weights_float;
+    const auto losses_double = fit<double>(X, y, false, weights_double);
+    const auto losses_float = fit<float>(X, y, true, weights_float);
+
+    bool losses_close = losses_float.size() == losses_double.size();
+    for (size_t e = 0; losses_close && e < losses_double.size(); ++e) {
+        losses_close = std::fabs(losses_float[e] - losses_double[e]) <= 1e-5 * (1 + losses_double[e]);
+    }
+    check("float with master weights: per-epoch losses match double within 1e-5", losses_close);
+    bool weights_close = weights_float.size() == weights_double.size();
+    for (size_t i = 0; weights_close && i < weights_double.size(); ++i) {
+        weights_close = std::fabs(weights_float[i] - weights_double[i]) <= 1e-5;
+    }
+    check("float with master weights: weights match double within 1e-5", weights_close);
+    check("the double run fits the regression",
+          std::fabs(weights_double[0] - 2) < 0.05 && std::fabs(weights_double[1] + 0.5) < 0.05 &&
+              std::fabs(weights_double[n_features] - 1) < 0.05);
+
+    const Small one = small_updates(true, 1);
+    check("an update below float resolution leaves the float weight at 1", one.value == 1.0f);
+    check("an update below float resolution is kept in the master copy",
+          std::fabs(one.master - (1 + small_step)) < 1e-15);
+
+    constexpr size_t steps = 1000;
+    const Small many = small_updates(true, steps);
+    const double expected = 1 + steps * small_step;
+    check("1000 small updates accumulate in the master copy", std::fabs(many.master - expected) < 1e-12);
+    check("the float weight follows the master copy", many.value == static_cast<float>(many.master) &&
+                                                          many.value > 1.0f);
+
+    const Small plain = small_updates(false, steps);
+    check("without master weights the same updates are lost", plain.value == 1.0f && std::isnan(plain.master));
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+// Checks GradientDescent::compute_gradients on a model against central finite
+// differences of the loss, for each loss with a direct gradient(), and checks
+// those gradients against the graph-based default of LossFunction.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+#include "loss/crossentropy/BinaryCrossEntropyWithLogits.h"
+#include "loss/crossentropy/SoftmaxCrossEntropy.h"
+#include "loss/mse/MSE.h"
+#include "model/sequential/Sequential.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    using Variable = std::shared_ptr<autodiff::BasicVariable<double>>;
+
+    constexpr size_t n_samples = 7;
+    constexpr size_t n_inputs = 4;
+    constexpr size_t n_hidden = 5;
+    constexpr size_t n_outputs = 3;
+
+    int failures = 0;
+
+    void expect(const char* what, const bool ok, const double error) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s (max error %.3g)\n", ok ? "ok" : "FAIL", what, error);
+    }
+
+    double loss_at(Model<double>& model, const MatrixView<double>& X, const std::vector<double>& y,
+                   LossFunction<double>& loss) {
+        const MatrixView<double> out = model.forward(X);
+        std::vector<double> y_pred;
+        for (size_t i = 0; i < out.rows; ++i) {
+            const auto row = out.row(i);
+            y_pred.insert(y_pred.end(), row.begin(), row.end());
+        }
+        return loss.value(y_pred, y);
+    }
+
+    // Relative error of every parameter gradient against (L(p + h) - L(p - h)) / 2h.
+    void check_model(const char* name, LossFunction<double>& loss, const std::vector<double>& y) {
+        std::mt19937_64 rng(3);
+        std::normal_distribution<double> normal;
+        std::vector<double> x(n_samples * n_inputs);
+        for (auto& v : x) v = normal(rng);
+        const MatrixView<double> X{x.data(), n_samples, n_inputs, n_inputs};
+
+        const auto model = Sequential<double>::mlp({n_inputs, n_hidden, n_outputs}, 11, 1);
+        auto params = model->parameters();
+        Vanilla<double> optimizer;
+        const double loss_value = optimizer.compute_gradients(*model, X, y, loss);
+
+        constexpr double h = 1e-6;
+        double worst = 0;
+        for (const auto& param : params) {
+            const double value = param->value();
+            param->set_value(value + h);
+            const double plus = loss_at(*model, X, y, loss);
+            param->set_value(value - h);
+            const double minus = loss_at(*model, X, y, loss);
+            param->set_value(value);
+
+            const double numeric = (plus - minus) / (2 * h);
+            worst = std::max(worst, std::fabs(param->grad() - numeric) / std::max(1.0, std::fabs(numeric)));
+        }
+        std::printf("     %s: loss %.6f over %zu parameters\n", name, loss_value, params.size());
+        expect("parameter gradients match finite differences", worst < 1e-7, worst);
+        expect("loss matches value()", std::fabs(loss_value - loss_at(*model, X, y, loss)) < 1e-12,
+               std::fabs(loss_value - loss_at(*model, X, y, loss)));
+    }
+
+    // The direct gradient() against the default that differentiates compute().
+    void check_loss(const char* name, LossFunction<double>& loss, const std::vector<double>& y_pred,
+                    const std::vector<double>& y) {
+        std::vector<double> direct(y_pred.size());
+        std::vector<double> graph(y_pred.size());
+        const double direct_loss = loss.gradient(y_pred, y, direct);
+        const double graph_loss = loss.LossFunction<double>::gradient(y_pred, y, graph);
+
+        double worst = std::fabs(direct_loss - graph_loss);
+        for (size_t i = 0; i < y_pred.size(); ++i) {
+            worst = std::max(worst, std::fabs(direct[i] - graph[i]));
+        }
+        std::printf("     %s:\n", name);
+        expect("gradient() matches the graph", worst < 1e-12, worst);
+    }
+
+    // Values set through parameters() reach the next forward, and backward adds
+    // to the parameters' gradients rather than replacing them.
+    void check_parameters() {
+        Dense<double> layer(2, 1, 5, 1);
+        const auto params = layer.parameters();
+        params[0]->set_value(2);
+        params[1]->set_value(-1);
+        params[2]->set_value(0.5);
+
+        const std::vector<double> x = {3, 4};
+        const double out = layer.forward({x.data(), 1, 2, 2}).row(0)[0];
+        expect("forward reads values set through parameters()", out == 2 * 3 - 4 + 0.5, std::fabs(out - 2.5));
+
+        const std::vector<double> dy = {1};
+        params[0]->set_grad(10);
+        layer.backward({dy.data(), 1, 1, 1}, {});
+        layer.backward({dy.data(), 1, 1, 1}, {});
+        const double error = std::max({std::fabs(params[0]->grad() - 16), std::fabs(params[1]->grad() - 8),
+                                       std::fabs(params[2]->grad() - 2)});
+        expect("backward accumulates into the parameters' gradients", error == 0, error);
+    }
+
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> normal;
+    std::bernoulli_distribution coin;
+    std::uniform_int_distribution<int> label(0, n_outputs - 1);
+
+    std::vector<double> regression(n_samples * n_outputs);
+    std::vector<double> binary(n_samples * n_outputs);
+    std::vector<double> labels(n_samples);
+    for (auto& v : regression) v = normal(rng);
+    for (auto& v : binary) v = coin(rng) ? 1 : 0;
+    for (auto& v : labels) v = label(rng);
+
+    MSE<double> mse;
+    BinaryCrossEntropyWithLogits<double> bce;
+    SoftmaxCrossEntropy<double> softmax(n_outputs);
+
+    check_model("MSE", mse, regression);
+    check_model("BinaryCrossEntropyWithLogits", bce, binary);
+    check_model("SoftmaxCrossEntropy", softmax, labels);
+
+    std::vector<double> logits(n_samples * n_outputs);
+    for (auto& v : logits) v = 4 * normal(rng);
+    check_loss("MSE", mse, logits, regression);
+    check_loss("BinaryCrossEntropyWithLogits", bce, logits, binary);
+    check_loss("SoftmaxCrossEntropy", softmax, logits, labels);
+
+    check_parameters();
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+// Online learners on a known linear target, y = 0.5 + 2 x0 - 3 x1 + 0.25 x2
+// with standard normal features: OnlineSGD (plain and normalized) and
+// RecursiveLeastSquares must recover its weights, through both the per-sample
+// and the batch update. Inputs whose shape does not match n_features() must be
+// rejected before anything is learned.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "optimizers/online/OnlineSGD.h"
+#include "optimizers/online/RecursiveLeastSquares.h"
+
+namespace {
+
+    int failures = 0;
+
+    constexpr size_t n_features = 3;
+    constexpr double coefficients[n_features + 1] = {2, -3, 0.25, 0.5}; // Bias last
+
+    struct Dataset {
+        std::vector<double> X; // Row-major, n_features columns
+        std::vector<double> y;
+
+        size_t rows() const { return y.size(); }
+        std::span<const double> row(const size_t i) const { return {X.data() + i * n_features, n_features}; }
+        MatrixView<double> view() const { return {X.data(), rows(), n_features, n_features}; }
+    };
+
+    Dataset make_dataset(const size_t rows) {
+        std::mt19937_64 rng(11);
+        std::normal_distribution<double> normal;
+        Dataset data;
+        for (size_t i = 0; i < rows; ++i) {
+            double target = coefficients[n_features];
+            for (size_t j = 0; j < n_features; ++j) {
+                const double x = normal(rng);
+                data.X.push_back(x);
+                target += coefficients[j] * x;
+            }
+            data.y.push_back(target);
+        }
+        return data;
+    }
+
+    double weight_error(const OnlineLearner<double>& learner) {
+        const auto w = learner.weights();
+        double error = 0;
+        for (size_t j = 0; j <= n_features; ++j) {
+            error = std::max(error, std::fabs(w[j] - coefficients[j]));
+        }
+        return error;
+    }
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    void check_converges(const std::string& what, OnlineLearner<double>& learner, const Dataset& data,
+                         const bool batch, const double tolerance) {
+        double last_error = 0;
+        if (batch) {
+            std::vector<double> predictions(data.rows());
+            learner.update(data.view(), data.y, predictions);
+            last_error = std::fabs(predictions.back() - data.y.back());
+        } else {
+            for (size_t i = 0; i < data.rows(); ++i) {
+                last_error = std::fabs(learner.update(data.row(i), data.y[i]) - data.y[i]);
+            }
+        }
+        const double error = weight_error(learner);
+        const bool ok = error <= tolerance && last_error <= tolerance;
+        if (!ok) ++failures;
+        std::printf("%-4s %-50s weight error %.2e  last prediction error %.2e\n", ok ? "ok" : "FAIL",
+                    what.c_str(), error, last_error);
+    }
+
+    template <typename Call>
+    bool rejects(Call&& call) {
+        try {
+            call();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    }
+
+    void check_shapes(const std::string& what, OnlineLearner<double>& learner) {
+        const Dataset data = make_dataset(4);
+        learner.update(data.view(), data.y); // So the weights are not all zero
+        const std::vector<double> before(learner.weights().begin(), learner.weights().end());
+        const std::vector<double> longer(n_features + 1, 1.0);
+        const std::vector<double> shorter(n_features - 1, 1.0);
+        const Dataset wide = [] {
+            Dataset d;
+            d.X.assign(4 * (n_features + 1), 1.0);
+            d.y.assign(4, 1.0);
+            return d;
+        }();
+        std::vector<double> predictions(data.rows() + 1);
+
+        check(what + ": predict rejects a longer x", rejects([&] { learner.predict(longer); }));
+        check(what + ": predict rejects a shorter x", rejects([&] { learner.predict(shorter); }));
+        check(what + ": update rejects a longer x", rejects([&] { learner.update(longer, 1.0); }));
+        check(what + ": update rejects a shorter x", rejects([&] { learner.update(shorter, 1.0); }));
+        check(what + ": batch update rejects extra columns", rejects([&] {
+                  learner.update(MatrixView<double>{wide.X.data(), 4, n_features + 1, n_features + 1}, wide.y);
+              }));
+        check(what + ": batch update rejects missing targets", rejects([&] {
+                  learner.update(data.view(), std::span<const double>(data.y).first(data.rows() - 1));
+              }));
+        check(what + ": batch update rejects a wrong prediction count", rejects([&] {
+                  learner.update(data.view(), data.y, predictions);
+              }));
+        check(what + ": rejected calls leave the weights unchanged",
+              std::equal(before.begin(), before.end(), learner.weights().begin()));
+    }
+
+}
+
+int main() {
+    const Dataset data = make_dataset(2000);
+
+    for (const bool batch : {false, true}) {
+        const std::string path = batch ? " (batch)" : "";
+        OnlineSGD<double> sgd(n_features, 0.05);
+        check_converges("OnlineSGD, learning rate 0.05" + path, sgd, data, batch, 1e-6);
+        OnlineSGD<double> nlms(n_features, 0.5, true);
+        check_converges("OnlineSGD, normalized, learning rate 0.5" + path, nlms, data, batch, 1e-6);
+        RecursiveLeastSquares<double> rls(n_features);
+        check_converges("RecursiveLeastSquares" + path, rls, data, batch, 1e-4);
+    }
+
+    OnlineSGD<double> sgd(n_features, 0.05);
+    check_shapes("OnlineSGD", sgd);
+    RecursiveLeastSquares<double> rls(n_features);
+    check_shapes("RecursiveLeastSquares", rls);
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
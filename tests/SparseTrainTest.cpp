@@ -0,0 +1,121 @@
+// Vanilla's sparse train step against the dense one: on the same data, a
+// CsrMatrix step and a nested-vector step must produce the same loss and
+// weights, for several steps in a row and for each loss. A sparse step whose
+// loss throws must not affect the steps after it on the same thread.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "loss/crossentropy/BinaryCrossEntropyWithLogits.h"
+#include "loss/crossentropy/SoftmaxCrossEntropy.h"
+#include "loss/mse/MSE.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    using Variable = std::shared_ptr<autodiff::BasicVariable<double>>;
+
+    int failures = 0;
+
+    constexpr size_t n_rows = 60;
+    constexpr size_t n_features = 25;
+    constexpr size_t n_steps = 5;
+    constexpr double tolerance = 1e-12;
+
+    struct Problem {
+        std::vector<std::vector<double>> dense;
+        CsrMatrix<double> sparse;
+        std::vector<double> y;
+    };
+
+    // Most entries are zero and some columns are zero in every row, so the
+    // sparse step leaves parameters untouched that the dense step visits.
+    Problem make_problem() {
+        std::mt19937_64 rng(17);
+        std::normal_distribution<double> normal;
+        std::uniform_int_distribution<int> keep(0, 4);
+        Problem problem;
+        for (size_t i = 0; i < n_rows; ++i) {
+            std::vector<double> row(n_features, 0.0);
+            for (size_t j = 0; j < n_features; ++j) {
+                if (j % 7 != 3 && keep(rng) == 0) row[j] = normal(rng);
+            }
+            problem.dense.push_back(std::move(row));
+            problem.y.push_back(normal(rng) > 0 ? 1.0 : 0.0);
+        }
+        problem.sparse = CsrMatrix<double>::from_dense(problem.dense);
+        return problem;
+    }
+
+    std::vector<Variable> make_weights() {
+        std::vector<Variable> w;
+        for (size_t j = 0; j <= n_features; ++j) {
+            w.push_back(autodiff::BasicVariable<double>::create(0.05 * static_cast<double>(j) - 0.4, true));
+        }
+        return w;
+    }
+
+    double max_difference(const std::vector<Variable>& a, const std::vector<Variable>& b) {
+        double difference = 0;
+        for (size_t j = 0; j < a.size(); ++j) {
+            difference = std::max(difference, std::fabs(a[j]->value() - b[j]->value()));
+        }
+        return difference;
+    }
+
+    void report(const std::string& what, const double loss_difference, const double weight_difference) {
+        const bool ok = loss_difference <= tolerance && weight_difference <= tolerance;
+        if (!ok) ++failures;
+        std::printf("%-4s %-44s loss difference %.2e  weight difference %.2e\n", ok ? "ok" : "FAIL", what.c_str(),
+                    loss_difference, weight_difference);
+    }
+
+    void check_steps(const std::string& what, const Problem& problem, LossFunction<double>& loss) {
+        Vanilla<double> dense_optimizer;
+        Vanilla<double> sparse_optimizer;
+        auto w_dense = make_weights();
+        auto w_sparse = make_weights();
+        double loss_difference = 0;
+        for (size_t step = 0; step < n_steps; ++step) {
+            const double dense_loss = dense_optimizer.train(w_dense, problem.dense, problem.y, loss, 0.1);
+            const double sparse_loss = sparse_optimizer.train(w_sparse, problem.sparse, problem.y, loss, 0.1);
+            loss_difference = std::max(loss_difference, std::fabs(dense_loss - sparse_loss));
+        }
+        report(what, loss_difference, max_difference(w_dense, w_sparse));
+    }
+
+}
+
+int main() {
+    const Problem problem = make_problem();
+    MSE<double> mse;
+    BinaryCrossEntropyWithLogits<double> bce;
+    check_steps("MSE: sparse steps match dense steps", problem, mse);
+    check_steps("BCE: sparse steps match dense steps", problem, bce);
+
+    // One logit per sample and labels that are not class indices: the loss
+    // throws after the sparse step has walked every row.
+    SoftmaxCrossEntropy<double> softmax(1);
+    const std::vector<double> bad_labels(n_rows, 3.0);
+    Vanilla<double> optimizer;
+    auto w = make_weights();
+    bool threw = false;
+    try {
+        optimizer.train(w, problem.sparse, bad_labels, softmax, 0.1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    if (!threw) ++failures;
+    std::printf("%-4s the sparse step rethrows the loss's error\n", threw ? "ok" : "FAIL");
+    check_steps("MSE: sparse steps match after a failed step", problem, mse);
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
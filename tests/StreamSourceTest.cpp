@@ -0,0 +1,201 @@
+// Streaming sources: data written as CSV or as a binary dataset comes back
+// through CsvSource and BinarySource row for row, in order, in chunks of the
+// requested size, and again after reset(); PrefetchSource around either gives
+// the same chunks in the same order; and truncated binary files and CSV rows
+// with too many or too few columns are rejected instead of being read as a
+// shorter dataset.
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "data/stream/BinarySource.h"
+#include "data/stream/CsvSource.h"
+#include "data/stream/PrefetchSource.h"
+
+namespace {
+
+    using Matrix = std::vector<std::vector<double>>;
+
+    int failures = 0;
+
+    constexpr size_t n_rows = 1000;
+    constexpr size_t n_features = 5;
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    std::string temp_dir() {
+        char name[] = "/tmp/gd_stream_XXXXXX";
+        if (!::mkdtemp(name)) throw std::runtime_error("mkdtemp failed");
+        return name;
+    }
+
+    void write_text(const std::string& path, const std::string& text) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << text;
+    }
+
+    // %.17g round-trips every double through from_chars exactly.
+    void write_csv(const std::string& path, const Matrix& X, const std::vector<double>& y, const bool target_first) {
+        std::string text = "header\n";
+        char field[32];
+        for (size_t i = 0; i < y.size(); ++i) {
+            std::vector<double> row = X[i];
+            if (target_first) {
+                row.insert(row.begin(), y[i]);
+            } else {
+                row.push_back(y[i]);
+            }
+            for (size_t j = 0; j < row.size(); ++j) {
+                std::snprintf(field, sizeof(field), "%s%.17g", j == 0 ? "" : ",", row[j]);
+                text += field;
+            }
+            // Windows line endings on every other row.
+            text += i % 2 == 0 ? "\n" : "\r\n";
+        }
+        write_text(path, text);
+    }
+
+    template <autodiff::Scalar T>
+    std::vector<Chunk<T>> read_all(DataSource<T>& source) {
+        std::vector<Chunk<T>> chunks;
+        Chunk<T> chunk;
+        while (source.next(chunk)) {
+            chunks.push_back(chunk);
+        }
+        return chunks;
+    }
+
+    // Every chunk but the last is full, and together they hold X and y in order.
+    bool matches(const std::vector<Chunk<double>>& chunks, const Matrix& X, const std::vector<double>& y,
+                 const size_t chunk_rows) {
+        size_t row = 0;
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            const auto& chunk = chunks[c];
+            if (chunk.rows() == 0 || chunk.rows() > chunk_rows || chunk.X.size() != chunk.rows()) return false;
+            if (c + 1 < chunks.size() && chunk.rows() != chunk_rows) return false;
+            for (size_t i = 0; i < chunk.rows(); ++i, ++row) {
+                if (row >= y.size() || chunk.X[i] != X[row] || chunk.y[i] != y[row]) return false;
+            }
+        }
+        return row == y.size();
+    }
+
+    bool same_chunks(const std::vector<Chunk<double>>& a, const std::vector<Chunk<double>>& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t c = 0; c < a.size(); ++c) {
+            if (a[c].X != b[c].X || a[c].y != b[c].y) return false;
+        }
+        return true;
+    }
+
+    // Reads two passes from `open(chunk_rows)` directly and through PrefetchSource.
+    void check_source(const std::string& what, const std::function<std::shared_ptr<DataSource<double>>(size_t)>& open,
+                      const Matrix& X, const std::vector<double>& y) {
+        for (const size_t chunk_rows : {size_t{1}, size_t{64}, size_t{250}, size_t{999}, n_rows, n_rows + 1}) {
+            const std::string name = what + ", " + std::to_string(chunk_rows) + " rows per chunk";
+            const auto source = open(chunk_rows);
+            check(name + ": n_features", source->n_features() == n_features);
+            const auto first = read_all(*source);
+            check(name + ": gives back the rows written, in order", matches(first, X, y, chunk_rows));
+            Chunk<double> chunk;
+            check(name + ": stays exhausted", !source->next(chunk));
+            source->reset();
+            check(name + ": reset() starts the same pass again", same_chunks(read_all(*source), first));
+
+            PrefetchSource<double> prefetch(open(chunk_rows));
+            check(name + ": prefetched chunks match the source", same_chunks(read_all(prefetch), first));
+            prefetch.reset();
+            check(name + ": prefetched chunks match after reset()", same_chunks(read_all(prefetch), first));
+        }
+    }
+
+    template <typename Open>
+    bool throws_runtime_error(Open&& open) {
+        try {
+            const auto source = open();
+            read_all(*source);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
+}
+
+int main() {
+    std::mt19937_64 rng(29);
+    std::normal_distribution<double> normal;
+    Matrix X(n_rows, std::vector<double>(n_features));
+    std::vector<double> y(n_rows);
+    for (size_t i = 0; i < n_rows; ++i) {
+        for (auto& x : X[i]) x = normal(rng) * 1e3;
+        y[i] = normal(rng);
+    }
+
+    const std::string dir = temp_dir();
+    const std::string csv = dir + "/data.csv";
+    const std::string csv_target_first = dir + "/target_first.csv";
+    const std::string binary = dir + "/data.bin";
+    const std::string bad = dir + "/bad";
+    write_csv(csv, X, y, false);
+    write_csv(csv_target_first, X, y, true);
+    BinarySource<double>::write(binary, X, y);
+
+    check_source("CSV", [&](const size_t rows) { return std::make_shared<CsvSource<double>>(csv, rows); }, X, y);
+    check_source("CSV, target first", [&](const size_t rows) {
+        return std::make_shared<CsvSource<double>>(csv_target_first, rows, 0);
+    }, X, y);
+    check_source("binary", [&](const size_t rows) { return std::make_shared<BinarySource<double>>(binary, rows); },
+                 X, y);
+    check("binary: n_rows from the header", BinarySource<double>(binary).n_rows() == n_rows);
+
+    // Truncated binary files: partway through a record, on a record boundary,
+    // and down to the header alone.
+    std::ifstream in(binary, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const size_t record = sizeof(double) * (n_features + 1);
+    for (const size_t cut : {size_t{3}, record, 10 * record + 1, n_rows * record}) {
+        write_text(bad, bytes.substr(0, bytes.size() - cut));
+        check("binary truncated by " + std::to_string(cut) + " bytes is rejected",
+              throws_runtime_error([&] { return std::make_shared<BinarySource<double>>(bad, 64); }));
+    }
+    write_text(bad, bytes + std::string(record, '\0'));
+    check("binary with rows past its header's count is rejected",
+          throws_runtime_error([&] { return std::make_shared<BinarySource<double>>(bad, 64); }));
+    check("binary read as float is rejected",
+          throws_runtime_error([&] { return std::make_shared<BinarySource<float>>(binary, 64); }));
+
+    const auto open_csv = [&] { return std::make_shared<CsvSource<double>>(bad, 2); };
+    const auto prefetch_csv = [&] { return std::make_shared<PrefetchSource<double>>(open_csv()); };
+    write_text(bad, "a,b,y\n1,2,3\n4,5,6\n7,8,9,10\n");
+    check("CSV row with an extra column is rejected", throws_runtime_error(open_csv));
+    check("CSV row with an extra column is rejected through PrefetchSource", throws_runtime_error(prefetch_csv));
+    write_text(bad, "a,b,y\n1,2,3\n4,5,6,\n");
+    check("CSV row with a trailing comma is rejected", throws_runtime_error(open_csv));
+    write_text(bad, "a,b,y\n1,2,3\n4,5\n");
+    check("CSV row with a missing column is rejected", throws_runtime_error(open_csv));
+    check("CSV row with a missing column is rejected through PrefetchSource", throws_runtime_error(prefetch_csv));
+    write_text(bad, "a,b,y\n1,2,3\n4,x,6\n");
+    check("CSV field that is not a number is rejected", throws_runtime_error(open_csv));
+
+    for (const auto& path : {csv, csv_target_first, binary, bad}) {
+        std::remove(path.c_str());
+    }
+    ::rmdir(dir.c_str());
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+// Sweep on y = 1 + 2 x0 with two unrelated columns: converged runs are ranked
+// by loss, diverged runs (including NaN losses) come last ordered by how long
+// they lasted, feature windows select the right columns, results do not depend
+// on the thread count, and a window past the last column is rejected.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "loss/mse/MSE.h"
+#include "optimizers/sweep/Sweep.h"
+
+namespace {
+
+    int failures = 0;
+
+    using SweepD = Sweep<double>;
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    bool same_config(const SweepD::Config& a, const SweepD::Config& b) {
+        const bool same_rate = a.learning_rate == b.learning_rate ||
+                               (std::isnan(a.learning_rate) && std::isnan(b.learning_rate));
+        return same_rate && a.window_begin == b.window_begin && a.window_size == b.window_size;
+    }
+
+    const SweepD::Result* find(const std::vector<SweepD::Result>& results, const SweepD::Config& config) {
+        for (const auto& result : results) {
+            if (same_config(result.config, config)) return &result;
+        }
+        return nullptr;
+    }
+
+}
+
+int main() {
+    std::mt19937_64 rng(29);
+    std::normal_distribution<double> normal;
+    SweepD::Matrix X;
+    SweepD::Vector y;
+    for (size_t i = 0; i < 64; ++i) {
+        const double x0 = normal(rng);
+        X.push_back({x0, normal(rng), normal(rng)});
+        y.push_back(1 + 2 * x0);
+    }
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<SweepD::Config> configs = {
+        {0.01},        // Converges slowly
+        {0.1},         // Converges
+        {0.1, 1, 0},   // Columns 1 and 2 only: cannot fit the target
+        {0.1, 0, 1},   // Column 0 only: fits the target
+        {3.0},         // Diverges after a few epochs
+        {inf},         // NaN losses from the second epoch on
+        {0.05, 2, 5},  // Window clamped to the last column
+    };
+
+    MSE<double> mse;
+    const SweepD sweep(200, 4);
+    const auto results = sweep.run(X, y, configs, mse);
+
+    check("one result per configuration", results.size() == configs.size());
+    bool ranked = true;
+    bool seen_diverged = false;
+    for (size_t r = 0; r < results.size(); ++r) {
+        if (results[r].diverged) {
+            seen_diverged = true;
+            if (r > 0 && results[r - 1].diverged && results[r - 1].epochs < results[r].epochs) ranked = false;
+        } else {
+            if (seen_diverged || !std::isfinite(results[r].loss)) ranked = false;
+            if (r > 0 && !results[r - 1].diverged && results[r - 1].loss > results[r].loss) ranked = false;
+        }
+    }
+    check("converged runs ranked by loss, then diverged runs by epochs", ranked);
+
+    const auto* fast = find(results, configs[1]);
+    const auto* slow = find(results, configs[0]);
+    const auto* wrong_columns = find(results, configs[2]);
+    const auto* right_column = find(results, configs[3]);
+    const auto* unstable = find(results, configs[4]);
+    const auto* nan = find(results, configs[5]);
+    const auto* clamped = find(results, configs[6]);
+    if (!fast || !slow || !wrong_columns || !right_column || !unstable || !nan || !clamped) {
+        std::printf("FAIL a configuration is missing from the results\n");
+        return EXIT_FAILURE;
+    }
+
+    check("learning rate 0.1 converges below 1e-10", !fast->diverged && fast->loss < 1e-10);
+    check("learning rate 0.01 ranks behind 0.1", !slow->diverged && slow->loss > fast->loss);
+    check("learning rate 3 diverges", unstable->diverged && unstable->epochs < 200);
+    check("an infinite learning rate diverges with a NaN loss", nan->diverged && std::isnan(nan->loss));
+
+    check("window [0, 1) has one feature weight and the bias", right_column->weights.size() == 2);
+    check("window [0, 1) recovers the weight and bias",
+          std::fabs(right_column->weights[0] - 2) < 1e-6 && std::fabs(right_column->weights[1] - 1) < 1e-6);
+    check("window [1, 3) has two feature weights and the bias", wrong_columns->weights.size() == 3);
+    check("window [1, 3) cannot fit the target", !wrong_columns->diverged && wrong_columns->loss > 1);
+    check("a window running past the last column is clamped to it", clamped->weights.size() == 2);
+
+    const SweepD serial(200, 1);
+    const auto serial_results = serial.run(X, y, configs, mse);
+    bool same = serial_results.size() == results.size();
+    for (size_t r = 0; same && r < results.size(); ++r) {
+        same = same_config(serial_results[r].config, results[r].config) &&
+               serial_results[r].epochs == results[r].epochs && serial_results[r].diverged == results[r].diverged;
+    }
+    check("one thread gives the same ranking as four", same);
+
+    bool threw = false;
+    try {
+        sweep.run(X, y, {{0.1}, {0.1, 3, 0}}, mse);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check("window_begin past the last column is rejected", threw);
+
+    threw = false;
+    try {
+        sweep.run(X, SweepD::Vector(y.begin(), y.end() - 1), {{0.1}}, mse);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check("too few targets are rejected", threw);
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
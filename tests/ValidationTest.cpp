@@ -0,0 +1,157 @@
+// fit() with a validation set, against a reference run that trains one epoch
+// at a time: validation_loss[e] must be the loss of the weights after epoch e
+// (although it is computed while epoch e + 1 trains), best_epoch must index the
+// best of them, patience must stop the run at the right epoch and restore the
+// best weights, and a run that uses all its epochs must keep its final weights.
+//
+// The model is fitted to y = x, while the validation target is y = 0.5 x: the
+// validation loss falls while the weight approaches 0.5 and then rises.
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "inference/Inference.h"
+#include "loss/mse/MSE.h"
+#include "optimizers/vanilla/Vanilla.h"
+
+namespace {
+
+    using Variable = std::shared_ptr<autodiff::BasicVariable<double>>;
+    using Matrix = std::vector<std::vector<double>>;
+
+    int failures = 0;
+
+    constexpr double learning_rate = 0.05;
+    constexpr size_t epochs = 60;
+
+    void check(const std::string& what, const bool ok) {
+        if (!ok) ++failures;
+        std::printf("%-4s %s\n", ok ? "ok" : "FAIL", what.c_str());
+    }
+
+    struct Data {
+        Matrix X;
+        std::vector<double> y;
+        Matrix validation_X;
+        std::vector<double> validation_y;
+    };
+
+    Data make_data() {
+        std::mt19937_64 rng(31);
+        std::normal_distribution<double> normal;
+        Data data;
+        for (size_t i = 0; i < 50; ++i) {
+            const double x = normal(rng);
+            data.X.push_back({x});
+            data.y.push_back(x);
+        }
+        for (size_t i = 0; i < 20; ++i) {
+            const double x = normal(rng);
+            data.validation_X.push_back({x});
+            data.validation_y.push_back(0.5 * x);
+        }
+        return data;
+    }
+
+    std::vector<Variable> make_weights() {
+        return {autodiff::BasicVariable<double>::create(0, true), autodiff::BasicVariable<double>::create(0, true)};
+    }
+
+    // Weights after each epoch, and their validation losses, one train() at a time.
+    struct Reference {
+        std::vector<std::vector<double>> weights;
+        std::vector<double> validation_loss;
+    };
+
+    Reference reference_run(const Data& data) {
+        Vanilla<double> optimizer;
+        MSE<double> mse;
+        auto w = make_weights();
+        Reference reference;
+        for (size_t e = 0; e < epochs; ++e) {
+            optimizer.train(w, data.X, data.y, mse, learning_rate);
+            reference.weights.push_back(inference::values(w));
+            reference.validation_loss.push_back(inference::evaluate(w, data.validation_X, data.validation_y, mse));
+        }
+        return reference;
+    }
+
+    // best_epoch as documented: the last epoch that improved on the best so far
+    // by more than min_delta.
+    size_t expected_best(const std::vector<double>& validation_loss, const double min_delta) {
+        size_t best = 0;
+        double best_loss = INFINITY;
+        for (size_t e = 0; e < validation_loss.size(); ++e) {
+            if (validation_loss[e] < best_loss - min_delta) {
+                best_loss = validation_loss[e];
+                best = e;
+            }
+        }
+        return best;
+    }
+
+    bool same_prefix(const std::vector<double>& a, const std::vector<double>& b) {
+        if (a.size() > b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i] != b[i]) return false;
+        }
+        return true;
+    }
+
+    void check_run(const std::string& what, const Data& data, const Reference& reference, const size_t patience,
+                   const double min_delta) {
+        Vanilla<double> optimizer;
+        MSE<double> mse;
+        auto w = make_weights();
+        optimizer.set_validation(data.validation_X, data.validation_y, patience, min_delta);
+        const auto losses = optimizer.fit(w, data.X, data.y, mse, learning_rate, epochs);
+        const auto& history = optimizer.history();
+
+        const size_t best = expected_best(reference.validation_loss, min_delta);
+        // Stopping is decided on collecting validation_loss[best + patience],
+        // which happens after epoch best + patience + 1 has trained.
+        const bool stops = patience > 0 && best + patience < epochs - 1;
+
+        check(what + ": validation_loss[e] is the loss after epoch e",
+              !history.validation_loss.empty() && same_prefix(history.validation_loss, reference.validation_loss));
+        check(what + ": best_epoch " + std::to_string(history.best_epoch) + " is the best validation epoch",
+              history.best_epoch == best);
+        check(what + ": history.loss matches the returned losses", history.loss == losses);
+        check(what + (stops ? ": stops early" : ": runs all epochs"), history.stopped_early == stops);
+        if (stops) {
+            check(what + ": stops after patience epochs without improvement",
+                  history.validation_loss.size() == best + patience + 1 && losses.size() == best + patience + 2);
+            check(what + ": restores the weights of the best epoch", inference::values(w) == reference.weights[best]);
+        } else {
+            check(what + ": validates every epoch", history.validation_loss.size() == epochs);
+            check(what + ": keeps the final weights", inference::values(w) == reference.weights.back());
+        }
+        check(what + ": counts the epochs that ran", optimizer.epoch() == losses.size());
+    }
+
+}
+
+int main() {
+    const Data data = make_data();
+    const Reference reference = reference_run(data);
+    const size_t best = expected_best(reference.validation_loss, 0);
+    std::printf("     reference: best validation epoch %zu of %zu\n", best, epochs);
+    if (best == 0 || best + 5 >= epochs || expected_best(reference.validation_loss, 5e-3) >= best) {
+        std::printf("FAIL the reference run should improve, by less than 5e-3 at the end, then get worse\n");
+        return EXIT_FAILURE;
+    }
+
+    check_run("no patience", data, reference, 0, 0);
+    check_run("patience 3", data, reference, 3, 0);
+    check_run("patience 1", data, reference, 1, 0);
+    check_run("patience 3, min_delta 5e-3", data, reference, 3, 5e-3);
+    check_run("patience longer than the run", data, reference, epochs, 0);
+
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+// Compares the statistics of WindowedFeatures with a direct recomputation in
+// long double: the single mean and deviation of standardized(), and, for
+// rolling(), the mean and deviation of every lookback window, which the
+// class slides in O(1) per point with periodic and cancellation-triggered
+// recomputes. The series are chosen to hit both triggers.
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "data/window/WindowedFeatures.h"
+
+namespace {
+
+    int failures = 0;
+
+    // Allowed error, in the units described at compare().
+    constexpr double tolerance = 64;
+
+    struct Stats {
+        long double mean;
+        long double scale;
+    };
+
+    // Population mean and standard deviation of series[begin, end); a zero
+    // deviation becomes 1, as in WindowedFeatures.
+    template <typename T>
+    Stats direct(const std::vector<T>& series, const size_t begin, const size_t end) {
+        long double mean = 0;
+        for (size_t t = begin; t < end; ++t) mean += series[t];
+        mean /= static_cast<long double>(end - begin);
+        long double m2 = 0;
+        for (size_t t = begin; t < end; ++t) {
+            const long double d = series[t] - mean;
+            m2 += d * d;
+        }
+        const long double scale = std::sqrt(m2 / static_cast<long double>(end - begin));
+        return {mean, scale > 0 ? scale : 1};
+    }
+
+    // Largest errors of the statistics behind each target and of the normalized
+    // targets, in units of what rounding alone allows: inputs and results are
+    // only known to within epsilon of T and of the accumulate type, relative to
+    // |mean| + scale, so a window with a large level and a small spread is
+    // ill-conditioned for any algorithm.
+    struct Errors {
+        double mean = 0;
+        double scale = 0;
+        double value = 0;
+    };
+
+    // The statistics are recovered through denormalize(): 0 maps to the mean
+    // and 1 to mean + scale.
+    template <typename T>
+    Errors compare(const WindowedFeatures<T>& features, const std::vector<T>& series,
+                   const std::vector<Stats>& expected) {
+        using Accum = autodiff::accumulate_t<T>;
+        constexpr long double eps = std::numeric_limits<T>::epsilon() + std::numeric_limits<Accum>::epsilon();
+
+        const size_t rows = features.rows();
+        std::vector<T> zeros(rows, T(0));
+        std::vector<T> ones(rows, T(1));
+        features.denormalize(zeros);
+        features.denormalize(ones);
+        const auto targets = features.targets();
+
+        Errors errors;
+        for (size_t i = 0; i < rows; ++i) {
+            const size_t t = features.offset() + features.window() + i;
+            const Stats& s = expected[i];
+            const long double unit = eps * (std::fabs(s.mean) + s.scale);
+            const long double z = (series[t] - s.mean) / s.scale;
+            const long double mean_error = std::fabs(zeros[i] - s.mean) / unit;
+            const long double scale_error = std::fabs((ones[i] - zeros[i]) - s.scale) / unit;
+            const long double value_error = std::fabs(targets[i] - z) / (unit / s.scale * (1 + std::fabs(z)));
+            errors.mean = std::max(errors.mean, static_cast<double>(mean_error));
+            errors.scale = std::max(errors.scale, static_cast<double>(scale_error));
+            errors.value = std::max(errors.value, static_cast<double>(value_error));
+        }
+        return errors;
+    }
+
+    template <typename T>
+    void report(const std::string& what, const Errors& errors, const double tolerance) {
+        const bool ok = errors.mean <= tolerance && errors.scale <= tolerance && errors.value <= tolerance;
+        if (!ok) ++failures;
+        std::printf("%-4s %-6s %-40s mean %7.2f  scale %7.2f  value %7.2f\n", ok ? "ok" : "FAIL",
+                    sizeof(T) == 4 ? "float" : "double", what.c_str(), errors.mean, errors.scale, errors.value);
+    }
+
+    template <typename T>
+    void check_rolling(const std::string& what, const std::vector<T>& series, const size_t window,
+                       const size_t lookback, const double tolerance) {
+        const auto features = WindowedFeatures<T>::rolling(series, window, lookback);
+        std::vector<Stats> expected;
+        for (size_t i = 0; i < features.rows(); ++i) {
+            const size_t t = lookback + window + i;
+            expected.push_back(direct(series, t - lookback, t));
+        }
+        report<T>(what + ", lookback " + std::to_string(lookback), compare(features, series, expected), tolerance);
+    }
+
+    template <typename T>
+    void check_standardized(const std::string& what, const std::vector<T>& series, const size_t window,
+                            const size_t train_rows, const double tolerance) {
+        const auto features = WindowedFeatures<T>::standardized(series, window, train_rows);
+        const size_t fit_rows = std::min(train_rows, series.size() - window);
+        const Stats fit = direct(series, 0, fit_rows + window);
+        const std::vector<Stats> expected(features.rows(), fit);
+        report<T>(what, compare(features, series, expected), tolerance);
+    }
+
+    template <typename T>
+    void check_all(const double tolerance) {
+        std::mt19937_64 rng(5);
+        std::normal_distribution<double> normal;
+        constexpr size_t length = 4000;
+
+        std::vector<T> noise(length);
+        for (auto& v : noise) v = static_cast<T>(normal(rng));
+
+        // A large level with small noise: each slide cancels most of the sum.
+        std::vector<T> offset(length);
+        for (auto& v : offset) v = static_cast<T>(1e4 + 1e-2 * normal(rng));
+
+        // Bursts of large values between near-constant stretches: the variance
+        // collapses as a burst leaves the window, which forces a recompute.
+        std::vector<T> bursts(length);
+        for (size_t t = 0; t < length; ++t) {
+            const bool burst = (t / 40) % 3 == 0;
+            bursts[t] = static_cast<T>(burst ? 1e3 * normal(rng) : 5 + 1e-3 * normal(rng));
+        }
+
+        // Exactly constant stretches give a zero deviation, mapped to a unit scale.
+        std::vector<T> steps(length);
+        for (size_t t = 0; t < length; ++t) steps[t] = static_cast<T>((t / 25) % 2 == 0 ? 3 : -1);
+
+        for (const size_t lookback : {2, 3, 16, 100}) {
+            check_rolling<T>("noise", noise, 5, lookback, tolerance);
+            check_rolling<T>("offset 1e4", offset, 5, lookback, tolerance);
+            check_rolling<T>("bursts", bursts, 3, lookback, tolerance);
+            check_rolling<T>("steps", steps, 4, lookback, tolerance);
+        }
+        check_standardized<T>("standardized noise, 500 training rows", noise, 8, 500, tolerance);
+        check_standardized<T>("standardized offset 1e4, all rows", offset, 8, WindowedFeatures<T>::all, tolerance);
+    }
+
+}
+
+int main() {
+    check_all<double>(tolerance);
+    check_all<float>(tolerance);
+    if (failures > 0) {
+        std::printf("%d check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}